@@ -0,0 +1,297 @@
+/*
+ * Benchmark Session Implementation
+ */
+
+#define _GNU_SOURCE
+#include "bench_session.h"
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// Task Groups
+// ============================================================================
+
+void task_group_init(TaskGroup *group) {
+    group->pending = 0;
+    group->cpu_seconds = 0.0;
+    pthread_mutex_init(&group->mutex, NULL);
+    pthread_cond_init(&group->done, NULL);
+}
+
+void task_group_wait(TaskGroup *group) {
+    pthread_mutex_lock(&group->mutex);
+    while (group->pending > 0) {
+        pthread_cond_wait(&group->done, &group->mutex);
+    }
+    pthread_mutex_unlock(&group->mutex);
+}
+
+void task_group_destroy(TaskGroup *group) {
+    pthread_mutex_destroy(&group->mutex);
+    pthread_cond_destroy(&group->done);
+}
+
+static void task_group_finish(TaskGroup *group, double cpu_seconds) {
+    pthread_mutex_lock(&group->mutex);
+    group->cpu_seconds += cpu_seconds;
+    group->pending--;
+    if (group->pending == 0) {
+        pthread_cond_broadcast(&group->done);
+    }
+    pthread_mutex_unlock(&group->mutex);
+}
+
+// ============================================================================
+// Thread Pool
+// ============================================================================
+
+// Worker loop: run queued tasks until the session ends
+static void *pool_worker(void *arg) {
+    ThreadPool *pool = (ThreadPool*)arg;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (1) {
+        while (!pool->head && !pool->shutdown) {
+            pthread_cond_wait(&pool->work, &pool->mutex);
+        }
+        if (!pool->head) {
+            break;
+        }
+        Task *task = pool->head;
+        pool->head = task->next;
+        if (!pool->head) {
+            pool->tail = NULL;
+        }
+        pool->queued_tasks--;
+        pool->idle_threads--;
+        pthread_mutex_unlock(&pool->mutex);
+
+        // Charge the task's own CPU time to its group
+        struct timespec cpu_start, cpu_end;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+        task->func(task->arg);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &pool->default_affinity);
+        task_group_finish(task->group, (cpu_end.tv_sec - cpu_start.tv_sec) +
+                                       (cpu_end.tv_nsec - cpu_start.tv_nsec) / 1e9);
+        free(task);
+
+        pthread_mutex_lock(&pool->mutex);
+        pool->idle_threads++;
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// Start one more worker (pool mutex held)
+static int pool_add_worker(ThreadPool *pool) {
+    if (pool->num_threads == pool->capacity) {
+        int capacity = pool->capacity ? pool->capacity * 2 : 16;
+        pthread_t *threads = realloc(pool->threads, capacity * sizeof(pthread_t));
+        if (!threads) {
+            return 0;
+        }
+        pool->threads = threads;
+        pool->capacity = capacity;
+    }
+    if (pthread_create(&pool->threads[pool->num_threads], NULL, pool_worker, pool) != 0) {
+        return 0;
+    }
+    pool->num_threads++;
+    pool->idle_threads++;
+    return 1;
+}
+
+static void thread_pool_init(ThreadPool *pool) {
+    memset(pool, 0, sizeof(*pool));
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &pool->default_affinity) != 0) {
+        CPU_ZERO(&pool->default_affinity);
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, &pool->default_affinity);
+        }
+    }
+}
+
+static void thread_pool_destroy(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    free(pool->threads);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->work);
+}
+
+int thread_pool_reserve(ThreadPool *pool, int num_threads) {
+    int ok = 1;
+    pthread_mutex_lock(&pool->mutex);
+    while (ok && pool->num_threads < num_threads) {
+        ok = pool_add_worker(pool);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return ok;
+}
+
+int thread_pool_busy(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    int busy = pool->num_threads - pool->idle_threads;
+    pthread_mutex_unlock(&pool->mutex);
+    return busy;
+}
+
+int thread_pool_submit(ThreadPool *pool, TaskGroup *group, TaskFunc func, void *arg) {
+    Task *task = (Task*)malloc(sizeof(Task));
+    if (!task) {
+        return 0;
+    }
+    task->func = func;
+    task->arg = arg;
+    task->group = group;
+    task->next = NULL;
+
+    pthread_mutex_lock(&pool->mutex);
+    // Every queued task needs a worker of its own, since tasks may wait on each other
+    if (pool->queued_tasks >= pool->idle_threads && !pool_add_worker(pool)) {
+        pthread_mutex_unlock(&pool->mutex);
+        free(task);
+        return 0;
+    }
+
+    pthread_mutex_lock(&group->mutex);
+    group->pending++;
+    pthread_mutex_unlock(&group->mutex);
+
+    if (pool->tail) {
+        pool->tail->next = task;
+    } else {
+        pool->head = task;
+    }
+    pool->tail = task;
+    pool->queued_tasks++;
+    pthread_cond_signal(&pool->work);
+    pthread_mutex_unlock(&pool->mutex);
+    return 1;
+}
+
+// ============================================================================
+// Buffer Pool
+// ============================================================================
+
+// Allocate one buffer and fault in its leading bytes
+static unsigned char *buffer_pool_allocate(BufferPool *buffers) {
+    unsigned char *buffer = malloc(buffers->buffer_size);
+    if (buffer) {
+        memset(buffer, 0, buffers->prefault_bytes);
+        buffers->allocated++;
+    }
+    return buffer;
+}
+
+unsigned char *buffer_pool_acquire(BufferPool *buffers) {
+    unsigned char *buffer = NULL;
+    pthread_mutex_lock(&buffers->mutex);
+    while (buffers->free_count == 0 && buffers->allocated >= buffers->max_buffers) {
+        pthread_cond_wait(&buffers->available, &buffers->mutex);
+    }
+    if (buffers->free_count > 0) {
+        buffer = buffers->free_buffers[--buffers->free_count];
+    } else {
+        buffer = buffer_pool_allocate(buffers);
+    }
+    pthread_mutex_unlock(&buffers->mutex);
+    return buffer;
+}
+
+void buffer_pool_release(BufferPool *buffers, unsigned char *buffer) {
+    if (!buffer) {
+        return;
+    }
+    pthread_mutex_lock(&buffers->mutex);
+    buffers->free_buffers[buffers->free_count++] = buffer;
+    pthread_cond_signal(&buffers->available);
+    pthread_mutex_unlock(&buffers->mutex);
+}
+
+void buffer_pool_reserve(BufferPool *buffers, size_t buffer_size, size_t prefault_bytes, int count) {
+    pthread_mutex_lock(&buffers->mutex);
+    if (count > buffers->max_buffers) {
+        count = buffers->max_buffers;
+    }
+    int freed = 0;
+    if (buffer_size != buffers->buffer_size) {
+        freed = buffers->free_count;
+        while (buffers->free_count > 0) {
+            free(buffers->free_buffers[--buffers->free_count]);
+            buffers->allocated--;
+        }
+        buffers->buffer_size = buffer_size;
+    }
+    buffers->prefault_bytes = prefault_bytes < buffer_size ? prefault_bytes : buffer_size;
+    if (buffers->free_count > count) {
+        freed += buffers->free_count - count;
+    }
+    while (buffers->free_count > count) {
+        free(buffers->free_buffers[--buffers->free_count]);
+        buffers->allocated--;
+    }
+    // Once freed buffers were served from the heap (glibc raises its mmap
+    // threshold after the first free), they would otherwise stay resident
+    if (freed > 0) {
+        malloc_trim(0);
+    }
+    while (buffers->free_count < count) {
+        unsigned char *buffer = buffer_pool_allocate(buffers);
+        if (!buffer) {
+            break;
+        }
+        buffers->free_buffers[buffers->free_count++] = buffer;
+    }
+    pthread_mutex_unlock(&buffers->mutex);
+}
+
+static int buffer_pool_init(BufferPool *buffers, int max_buffers) {
+    memset(buffers, 0, sizeof(*buffers));
+    buffers->max_buffers = max_buffers;
+    buffers->free_buffers = malloc(max_buffers * sizeof(unsigned char*));
+    if (!buffers->free_buffers) {
+        return 0;
+    }
+    pthread_mutex_init(&buffers->mutex, NULL);
+    pthread_cond_init(&buffers->available, NULL);
+    return 1;
+}
+
+static void buffer_pool_destroy(BufferPool *buffers) {
+    // All buffers are back on the free list once methods have finished
+    for (int i = 0; i < buffers->free_count; i++) {
+        free(buffers->free_buffers[i]);
+    }
+    free(buffers->free_buffers);
+    pthread_mutex_destroy(&buffers->mutex);
+    pthread_cond_destroy(&buffers->available);
+}
+
+// ============================================================================
+// Session
+// ============================================================================
+
+int session_init(BenchSession *session, int max_buffers) {
+    if (!buffer_pool_init(&session->buffers, max_buffers)) {
+        return 0;
+    }
+    thread_pool_init(&session->pool);
+    return 1;
+}
+
+void session_destroy(BenchSession *session) {
+    thread_pool_destroy(&session->pool);
+    buffer_pool_destroy(&session->buffers);
+}
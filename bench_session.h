@@ -0,0 +1,94 @@
+/*
+ * Benchmark Session Header
+ *
+ * Persistent worker threads and pre-faulted block buffers shared by every
+ * reading method and every repetition, so per-call setup stays out of the
+ * measurements (includers need _GNU_SOURCE for cpu_set_t)
+ */
+
+#ifndef BENCH_SESSION_H
+#define BENCH_SESSION_H
+
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
+
+typedef void *(*TaskFunc)(void *arg);
+
+// Completion counter for a batch of submitted tasks
+typedef struct {
+    int pending;
+    double cpu_seconds;   // thread CPU time used by the group's finished tasks
+    pthread_mutex_t mutex;
+    pthread_cond_t done;
+} TaskGroup;
+
+typedef struct Task {
+    TaskFunc func;
+    void *arg;
+    TaskGroup *group;
+    struct Task *next;
+} Task;
+
+// Worker threads that live for the whole session. Tasks may block on each
+// other (readers/consumers), so every queued task gets its own worker: the
+// pool grows whenever more tasks are queued than workers are idle.
+typedef struct {
+    pthread_t *threads;
+    int num_threads;
+    int capacity;
+    int idle_threads;
+    int queued_tasks;
+    Task *head;
+    Task *tail;
+    int shutdown;
+    pthread_mutex_t mutex;
+    pthread_cond_t work;
+    cpu_set_t default_affinity;  // restored after each task (tasks may pin)
+} ThreadPool;
+
+// Fixed-size block buffers, faulted in once and recycled
+typedef struct {
+    unsigned char **free_buffers;
+    int free_count;
+    int allocated;
+    int max_buffers;
+    size_t buffer_size;
+    size_t prefault_bytes;   // leading bytes touched at allocation
+    pthread_mutex_t mutex;
+    pthread_cond_t available;
+} BufferPool;
+
+typedef struct {
+    ThreadPool pool;
+    BufferPool buffers;
+} BenchSession;
+
+// Create a session whose pool holds up to max_buffers buffers; none exist
+// until buffer_pool_reserve sizes them
+int session_init(BenchSession *session, int max_buffers);
+void session_destroy(BenchSession *session);
+
+void task_group_init(TaskGroup *group);
+void task_group_wait(TaskGroup *group);
+void task_group_destroy(TaskGroup *group);
+
+// Make sure at least num_threads workers exist (call before timing)
+int thread_pool_reserve(ThreadPool *pool, int num_threads);
+
+// Workers currently running a task (blocked or parked tasks included)
+int thread_pool_busy(ThreadPool *pool);
+
+// Run func(arg) on a pool worker; returns 0 if no worker could be started
+int thread_pool_submit(ThreadPool *pool, TaskGroup *group, TaskFunc func, void *arg);
+
+// Take a buffer (blocks while all max_buffers are in use) and give it back
+unsigned char *buffer_pool_acquire(BufferPool *buffers);
+void buffer_pool_release(BufferPool *buffers, unsigned char *buffer);
+
+// Keep exactly count free buffers of buffer_size bytes, with prefault_bytes
+// touched, freeing or faulting in the difference; buffers of another size
+// are all replaced (call before timing, with every buffer released)
+void buffer_pool_reserve(BufferPool *buffers, size_t buffer_size, size_t prefault_bytes, int count);
+
+#endif // BENCH_SESSION_H
@@ -0,0 +1,258 @@
+/*
+ * Benchmark Statistics Implementation
+ */
+
+#include "bench_stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static int compare_doubles(const void *a, const void *b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+double stats_percentile(const double *sorted, int count, double p) {
+    if (count <= 0) {
+        return 0.0;
+    }
+    double rank = p / 100.0 * (count - 1);
+    int lower = (int)rank;
+    if (lower >= count - 1) {
+        return sorted[count - 1];
+    }
+    double fraction = rank - lower;
+    return sorted[lower] + fraction * (sorted[lower + 1] - sorted[lower]);
+}
+
+int stats_compute(const double *samples, int count, SampleStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (count <= 0) {
+        return 0;
+    }
+    double *sorted = malloc(count * sizeof(double));
+    if (!sorted) {
+        return 0;
+    }
+    memcpy(sorted, samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compare_doubles);
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += sorted[i];
+    }
+    stats->count = count;
+    stats->min = sorted[0];
+    stats->max = sorted[count - 1];
+    stats->mean = sum / count;
+    stats->median = stats_percentile(sorted, count, 50.0);
+    stats->p95 = stats_percentile(sorted, count, 95.0);
+
+    if (count > 1) {
+        double squares = 0.0;
+        for (int i = 0; i < count; i++) {
+            double delta = sorted[i] - stats->mean;
+            squares += delta * delta;
+        }
+        stats->stddev = sqrt(squares / (count - 1));
+    }
+    free(sorted);
+    return 1;
+}
+
+uint64_t stats_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void stats_shuffle(int *items, int count, uint64_t *state) {
+    for (int i = count - 1; i > 0; i--) {
+        int j = (int)(stats_random(state) % (uint64_t)(i + 1));
+        int tmp = items[i];
+        items[i] = items[j];
+        items[j] = tmp;
+    }
+}
+
+void stats_permutation(size_t *items, size_t count, uint64_t *state) {
+    for (size_t i = 0; i < count; i++) {
+        items[i] = i;
+    }
+    for (size_t i = count; i > 1; i--) {
+        size_t j = (size_t)(stats_random(state) % (uint64_t)i);
+        size_t tmp = items[i - 1];
+        items[i - 1] = items[j];
+        items[j] = tmp;
+    }
+}
+
+#define EXACT_MAX_SAMPLES 50   // per side, for the exact U distribution
+
+// Number of arrangements giving each U (0..na*nb) for samples of na and nb
+// without ties: f(i, j, u) = f(i - 1, j, u - j) + f(i, j - 1, u)
+static double *u_distribution(int na, int nb) {
+    int max_u = na * nb;
+    double *prev = calloc((size_t)(nb + 1) * (max_u + 1), sizeof(double));
+    double *curr = calloc((size_t)(nb + 1) * (max_u + 1), sizeof(double));
+    if (!prev || !curr) {
+        free(prev);
+        free(curr);
+        return NULL;
+    }
+    // i = 0: one arrangement, U = 0, for every j
+    for (int j = 0; j <= nb; j++) {
+        prev[(size_t)j * (max_u + 1)] = 1.0;
+    }
+    for (int i = 1; i <= na; i++) {
+        memset(curr, 0, (size_t)(nb + 1) * (max_u + 1) * sizeof(double));
+        curr[0] = 1.0;   // j = 0
+        for (int j = 1; j <= nb; j++) {
+            double *row = &curr[(size_t)j * (max_u + 1)];
+            const double *left = &curr[(size_t)(j - 1) * (max_u + 1)];
+            const double *up = &prev[(size_t)j * (max_u + 1)];
+            for (int u = 0; u <= i * j; u++) {
+                row[u] = left[u] + (u >= j ? up[u - j] : 0.0);
+            }
+        }
+        double *swap = prev;
+        prev = curr;
+        curr = swap;
+    }
+    // Keep only the (na, nb) row
+    memmove(prev, &prev[(size_t)nb * (max_u + 1)], (max_u + 1) * sizeof(double));
+    free(curr);
+    return prev;
+}
+
+// Two-sided exact p-value for an observed U
+static double exact_p(int na, int nb, double u) {
+    double *counts = u_distribution(na, nb);
+    if (!counts) {
+        return -1.0;
+    }
+    int max_u = na * nb;
+    double total = 0.0;
+    for (int k = 0; k <= max_u; k++) {
+        total += counts[k];
+    }
+    // Distribution is symmetric about max_u / 2: take the nearer tail, doubled
+    double tail_u = u < max_u - u ? u : max_u - u;
+    double tail = 0.0;
+    for (int k = 0; k <= (int)tail_u; k++) {
+        tail += counts[k];
+    }
+    free(counts);
+    double p = 2.0 * tail / total;
+    return p < 1.0 ? p : 1.0;
+}
+
+double stats_mann_whitney(const double *a, int na, const double *b, int nb, double *u) {
+    *u = 0.0;
+    if (na <= 0 || nb <= 0) {
+        return 1.0;
+    }
+    // U counts pairs with a ahead of b, ties as half
+    int ties = 0;
+    for (int i = 0; i < na; i++) {
+        for (int j = 0; j < nb; j++) {
+            if (a[i] > b[j]) {
+                *u += 1.0;
+            } else if (a[i] == b[j]) {
+                *u += 0.5;
+                ties = 1;
+            }
+        }
+    }
+    if (!ties && na <= EXACT_MAX_SAMPLES && nb <= EXACT_MAX_SAMPLES) {
+        double p = exact_p(na, nb, *u);
+        if (p >= 0.0) {
+            return p;
+        }
+    }
+    
+    // Normal approximation; the variance shrinks with tied groups across both samples
+    int n = na + nb;
+    double *pooled = malloc(n * sizeof(double));
+    if (!pooled) {
+        return 1.0;
+    }
+    memcpy(pooled, a, na * sizeof(double));
+    memcpy(pooled + na, b, nb * sizeof(double));
+    qsort(pooled, n, sizeof(double), compare_doubles);
+    double tie_term = 0.0;
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j < n && pooled[j] == pooled[i]) {
+            j++;
+        }
+        double t = j - i;
+        tie_term += t * t * t - t;
+        i = j;
+    }
+    free(pooled);
+    double mean = na * (double)nb / 2.0;
+    double variance = na * (double)nb / 12.0 * ((n + 1) - tie_term / ((double)n * (n - 1)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    double z = (fabs(*u - mean) - 0.5) / sqrt(variance);
+    if (z < 0.0) {
+        z = 0.0;
+    }
+    return erfc(z / sqrt(2.0));
+}
+
+double stats_mann_whitney_min_p(int na, int nb) {
+    if (na <= 0 || nb <= 0) {
+        return 1.0;
+    }
+    // Two-sided p of the most extreme arrangement: 2 / C(na + nb, na)
+    double combinations = 1.0;
+    for (int i = 1; i <= na; i++) {
+        combinations = combinations * (nb + i) / i;
+    }
+    double p = 2.0 / combinations;
+    return p < 1.0 ? p : 1.0;
+}
+
+// Median of count values drawn with replacement from samples
+static double resample_median(const double *samples, int count, double *scratch, uint64_t *state) {
+    for (int i = 0; i < count; i++) {
+        scratch[i] = samples[stats_random(state) % (uint64_t)count];
+    }
+    qsort(scratch, count, sizeof(double), compare_doubles);
+    return stats_percentile(scratch, count, 50.0);
+}
+
+void stats_bootstrap_median_ratio(const double *a, int na, const double *b, int nb,
+                                  int resamples, double confidence, uint64_t *state,
+                                  double *low, double *high) {
+    *low = *high = 0.0;
+    if (na <= 0 || nb <= 0 || resamples <= 0) {
+        return;
+    }
+    double *ratios = malloc(resamples * sizeof(double));
+    double *scratch = malloc((na > nb ? na : nb) * sizeof(double));
+    if (!ratios || !scratch) {
+        free(ratios);
+        free(scratch);
+        return;
+    }
+    int count = 0;
+    for (int r = 0; r < resamples; r++) {
+        double median_a = resample_median(a, na, scratch, state);
+        double median_b = resample_median(b, nb, scratch, state);
+        if (median_b > 0.0) {
+            ratios[count++] = median_a / median_b;
+        }
+    }
+    qsort(ratios, count, sizeof(double), compare_doubles);
+    double tail = (100.0 - confidence) / 2.0;
+    *low = stats_percentile(ratios, count, tail);
+    *high = stats_percentile(ratios, count, 100.0 - tail);
+    free(ratios);
+    free(scratch);
+}
@@ -0,0 +1,51 @@
+/*
+ * Benchmark Statistics Header
+ *
+ * Summary statistics over repeated timing samples
+ */
+
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    int count;
+    double min;
+    double max;
+    double mean;
+    double median;
+    double stddev;   // sample standard deviation (n - 1)
+    double p95;
+} SampleStats;
+
+// Summarize count samples (the input array is not modified)
+int stats_compute(const double *samples, int count, SampleStats *stats);
+
+// Percentile p (0-100) of an ascending array, linearly interpolated
+double stats_percentile(const double *sorted, int count, double p);
+
+// Seeded pseudo-random numbers (splitmix64), reproducible across runs
+uint64_t stats_random(uint64_t *state);
+
+// Fisher-Yates shuffle of count items driven by stats_random
+void stats_shuffle(int *items, int count, uint64_t *state);
+
+// Fill items with a random permutation of 0..count-1 (Fisher-Yates)
+void stats_permutation(size_t *items, size_t count, uint64_t *state);
+
+// Two-sided Mann-Whitney U test of a against b: returns the p-value and
+// stores U for a. Exact for small samples without ties, otherwise the normal
+// approximation with tie and continuity corrections.
+double stats_mann_whitney(const double *a, int na, const double *b, int nb, double *u);
+
+// Smallest two-sided p-value the test can reach for these sample sizes
+double stats_mann_whitney_min_p(int na, int nb);
+
+// Percentile bootstrap confidence interval (e.g. 95.0) for median(a) / median(b)
+void stats_bootstrap_median_ratio(const double *a, int na, const double *b, int nb,
+                                  int resamples, double confidence, uint64_t *state,
+                                  double *low, double *high);
+
+#endif // BENCH_STATS_H
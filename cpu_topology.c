@@ -0,0 +1,322 @@
+/*
+ * CPU Topology Discovery and Thread Pinning Implementation
+ */
+
+#define _GNU_SOURCE
+#include "cpu_topology.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+
+#define TOPOLOGY_MAX_CPUS 4096
+
+// Sort key used to build placement orders
+typedef struct {
+    int key[4];
+    int index;
+} PlacementKey;
+
+static int compare_keys(const void *a, const void *b) {
+    const PlacementKey *ka = (const PlacementKey*)a;
+    const PlacementKey *kb = (const PlacementKey*)b;
+    for (int i = 0; i < 4; i++) {
+        if (ka->key[i] != kb->key[i]) {
+            return ka->key[i] < kb->key[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Read a single integer from a sysfs file
+static int read_int_file(const char *path, int *value) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    int ok = fscanf(file, "%d", value) == 1;
+    fclose(file);
+    return ok;
+}
+
+// Parse a kernel cpulist ("0-3,8,10-11") into a membership map
+static int read_cpulist(const char *path, unsigned char *member, int max) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    char line[4096];
+    if (!fgets(line, sizeof(line), file)) {
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+
+    char *p = line;
+    while (*p && *p != '\n') {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long cpu = first; cpu <= last && cpu < max; cpu++) {
+            if (cpu >= 0) {
+                member[cpu] = 1;
+            }
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return 1;
+}
+
+// Build compact, scatter and SMT-pair placement orders
+static int build_orders(CpuTopology *topo) {
+    int n = topo->num_cpus;
+    PlacementKey *keys = malloc(n * sizeof(PlacementKey));
+    int *smt_rank = calloc(n, sizeof(int));
+    int *core_rank = calloc(n, sizeof(int));
+    topo->compact_order = malloc(n * sizeof(int));
+    topo->scatter_order = malloc(n * sizeof(int));
+    topo->smt_order = malloc(2 * n * sizeof(int));
+    if (!keys || !smt_rank || !core_rank || !topo->compact_order ||
+        !topo->scatter_order || !topo->smt_order) {
+        free(keys);
+        free(smt_rank);
+        free(core_rank);
+        return 0;
+    }
+
+    // Compact: node, package, core, then sibling
+    for (int i = 0; i < n; i++) {
+        const CpuInfo *c = &topo->cpus[i];
+        keys[i] = (PlacementKey){{c->node, c->package_id, c->core_id, c->cpu}, i};
+    }
+    qsort(keys, n, sizeof(PlacementKey), compare_keys);
+    for (int i = 0; i < n; i++) {
+        topo->compact_order[i] = keys[i].index;
+    }
+
+    // Rank each CPU among its SMT siblings, and its core among the node's cores
+    for (int i = 0; i < n; i++) {
+        const CpuInfo *c = &topo->cpus[i];
+        for (int j = 0; j < n; j++) {
+            const CpuInfo *o = &topo->cpus[j];
+            if (o->package_id == c->package_id && o->core_id == c->core_id && o->cpu < c->cpu) {
+                smt_rank[i]++;
+            }
+            if (o->node == c->node && o->cpu < c->cpu &&
+                (o->package_id != c->package_id || o->core_id != c->core_id)) {
+                // Count each lower core once, via its first sibling
+                int first_sibling = 1;
+                for (int k = 0; k < n; k++) {
+                    const CpuInfo *s = &topo->cpus[k];
+                    if (s->package_id == o->package_id && s->core_id == o->core_id && s->cpu < o->cpu) {
+                        first_sibling = 0;
+                        break;
+                    }
+                }
+                core_rank[i] += first_sibling;
+            }
+        }
+    }
+
+    // Scatter: first sibling of every core, round-robin across nodes
+    for (int i = 0; i < n; i++) {
+        keys[i] = (PlacementKey){{smt_rank[i], core_rank[i], topo->cpus[i].node, topo->cpus[i].cpu}, i};
+    }
+    qsort(keys, n, sizeof(PlacementKey), compare_keys);
+    for (int i = 0; i < n; i++) {
+        topo->scatter_order[i] = keys[i].index;
+    }
+
+    // SMT pairs: walk cores in compact order, emit two siblings per core
+    int pairs = 0;
+    for (int i = 0; i < n; i++) {
+        int first = topo->compact_order[i];
+        if (smt_rank[first] != 0) {
+            continue;
+        }
+        int second = first;
+        for (int j = 0; j < n; j++) {
+            if (smt_rank[j] == 1 &&
+                topo->cpus[j].package_id == topo->cpus[first].package_id &&
+                topo->cpus[j].core_id == topo->cpus[first].core_id) {
+                second = j;
+                break;
+            }
+        }
+        topo->smt_order[2 * pairs] = first;
+        topo->smt_order[2 * pairs + 1] = second;
+        pairs++;
+    }
+    // Fill the tail so slot lookups can simply wrap
+    for (int i = 2 * pairs; i < 2 * n; i++) {
+        topo->smt_order[i] = topo->smt_order[i % (2 * pairs)];
+    }
+
+    free(keys);
+    free(smt_rank);
+    free(core_rank);
+    return 1;
+}
+
+// Discover online CPUs and NUMA nodes
+int topology_discover(CpuTopology *topo) {
+    memset(topo, 0, sizeof(*topo));
+
+    unsigned char *online = calloc(TOPOLOGY_MAX_CPUS, 1);
+    if (!online) {
+        return 0;
+    }
+    if (!read_cpulist("/sys/devices/system/cpu/online", online, TOPOLOGY_MAX_CPUS)) {
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long cpu = 0; cpu < count && cpu < TOPOLOGY_MAX_CPUS; cpu++) {
+            online[cpu] = 1;
+        }
+    }
+
+    for (int cpu = 0; cpu < TOPOLOGY_MAX_CPUS; cpu++) {
+        topo->num_cpus += online[cpu];
+    }
+    if (topo->num_cpus == 0) {
+        free(online);
+        return 0;
+    }
+    topo->cpus = calloc(topo->num_cpus, sizeof(CpuInfo));
+    if (!topo->cpus) {
+        free(online);
+        return 0;
+    }
+
+    char path[256];
+    int index = 0;
+    for (int cpu = 0; cpu < TOPOLOGY_MAX_CPUS; cpu++) {
+        if (!online[cpu]) {
+            continue;
+        }
+        CpuInfo *info = &topo->cpus[index++];
+        info->cpu = cpu;
+        info->core_id = cpu;
+        info->package_id = 0;
+        info->node = 0;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        read_int_file(path, &info->core_id);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        read_int_file(path, &info->package_id);
+    }
+
+    // Map CPUs to NUMA nodes
+    topo->num_nodes = 1;
+    unsigned char nodes[TOPOLOGY_MAX_NODES] = {0};
+    if (read_cpulist("/sys/devices/system/node/online", nodes, TOPOLOGY_MAX_NODES)) {
+        for (int node = 0; node < TOPOLOGY_MAX_NODES; node++) {
+            if (!nodes[node]) {
+                continue;
+            }
+            if (node + 1 > topo->num_nodes) {
+                topo->num_nodes = node + 1;
+            }
+            memset(online, 0, TOPOLOGY_MAX_CPUS);
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            if (!read_cpulist(path, online, TOPOLOGY_MAX_CPUS)) {
+                continue;
+            }
+            for (int i = 0; i < topo->num_cpus; i++) {
+                if (online[topo->cpus[i].cpu]) {
+                    topo->cpus[i].node = node;
+                }
+            }
+        }
+    }
+    free(online);
+
+    if (!build_orders(topo)) {
+        topology_free(topo);
+        return 0;
+    }
+    return 1;
+}
+
+void topology_free(CpuTopology *topo) {
+    free(topo->cpus);
+    free(topo->compact_order);
+    free(topo->scatter_order);
+    free(topo->smt_order);
+    memset(topo, 0, sizeof(*topo));
+}
+
+// Logical CPU for placement slot under a policy
+int topology_cpu_for_slot(const CpuTopology *topo, PinPolicy policy, int slot) {
+    if (!topo->cpus || slot < 0) {
+        return -1;
+    }
+    switch (policy) {
+    case PIN_COMPACT:
+        return topo->cpus[topo->compact_order[slot % topo->num_cpus]].cpu;
+    case PIN_SCATTER:
+        return topo->cpus[topo->scatter_order[slot % topo->num_cpus]].cpu;
+    case PIN_SMT:
+        return topo->cpus[topo->smt_order[slot % (2 * topo->num_cpus)]].cpu;
+    default:
+        return -1;
+    }
+}
+
+// NUMA node of a logical CPU, or of the calling thread when cpu < 0
+int topology_node_of(const CpuTopology *topo, int cpu) {
+    if (cpu < 0) {
+        cpu = sched_getcpu();
+    }
+    for (int i = 0; i < topo->num_cpus; i++) {
+        if (topo->cpus[i].cpu == cpu) {
+            return topo->cpus[i].node;
+        }
+    }
+    return 0;
+}
+
+// Pin the calling thread to one logical CPU
+int topology_pin_self(int cpu) {
+    if (cpu < 0) {
+        return 0;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+int topology_parse_policy(const char *name, PinPolicy *policy) {
+    if (strcmp(name, "none") == 0) {
+        *policy = PIN_NONE;
+    } else if (strcmp(name, "compact") == 0) {
+        *policy = PIN_COMPACT;
+    } else if (strcmp(name, "scatter") == 0) {
+        *policy = PIN_SCATTER;
+    } else if (strcmp(name, "smt") == 0) {
+        *policy = PIN_SMT;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+const char *topology_policy_name(PinPolicy policy) {
+    switch (policy) {
+    case PIN_COMPACT: return "compact";
+    case PIN_SCATTER: return "scatter";
+    case PIN_SMT:     return "smt";
+    default:          return "none";
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * CPU Topology Discovery and Thread Pinning Header
+ *
+ * Reads /sys/devices/system/cpu and /sys/devices/system/node
+ */
+
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#define TOPOLOGY_MAX_NODES 64
+
+// Thread placement policies
+typedef enum {
+    PIN_NONE,      // let the scheduler place threads
+    PIN_COMPACT,   // fill one node (and its SMT siblings) before the next
+    PIN_SCATTER,   // spread across nodes and physical cores first
+    PIN_SMT        // slot 2k and 2k+1 share a physical core (reader/consumer pairs)
+} PinPolicy;
+
+// One logical CPU
+typedef struct {
+    int cpu;          // logical CPU id
+    int core_id;      // physical core id within the package
+    int package_id;   // socket
+    int node;         // NUMA node (0 when the kernel exposes no nodes)
+} CpuInfo;
+
+typedef struct {
+    CpuInfo *cpus;
+    int num_cpus;
+    int num_nodes;
+    int *compact_order;   // CPU indices in compact placement order
+    int *scatter_order;   // CPU indices in scatter placement order
+    int *smt_order;       // sibling pairs back to back, one pair per core
+} CpuTopology;
+
+// Discover online CPUs and NUMA nodes (returns 1 on success)
+int topology_discover(CpuTopology *topo);
+void topology_free(CpuTopology *topo);
+
+// Logical CPU for placement slot under a policy (-1 for PIN_NONE)
+int topology_cpu_for_slot(const CpuTopology *topo, PinPolicy policy, int slot);
+
+// NUMA node of a logical CPU, or of the calling thread when cpu < 0
+int topology_node_of(const CpuTopology *topo, int cpu);
+
+// Pin the calling thread to one logical CPU (returns 1 on success)
+int topology_pin_self(int cpu);
+
+// Parse policy name ("none", "compact", "scatter", "smt"); returns 0 if unknown
+int topology_parse_policy(const char *name, PinPolicy *policy);
+const char *topology_policy_name(PinPolicy policy);
+
+#endif // CPU_TOPOLOGY_H
@@ -9,6 +9,30 @@
 static uint64_t crc64_table[256];
 static int crc64_initialized = 0;
 
+// GF(2) operators that advance a CRC over 2^k zero bytes (row n = image of bit n)
+#define CRC64_SHIFT_LEVELS 64
+static uint64_t crc64_shift_ops[CRC64_SHIFT_LEVELS][64];
+
+// Multiply a GF(2) 64x64 matrix by a vector
+static uint64_t gf2_matrix_times(const uint64_t *mat, uint64_t vec) {
+    uint64_t sum = 0;
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+// square = mat * mat
+static void gf2_matrix_square(uint64_t *square, const uint64_t *mat) {
+    for (int n = 0; n < 64; n++) {
+        square[n] = gf2_matrix_times(mat, mat[n]);
+    }
+}
+
 // Initialize CRC64 lookup table
 void crc64_init(void) {
     if (crc64_initialized) {
@@ -30,6 +54,19 @@ void crc64_init(void) {
         crc64_table[i] = crc;
     }
     
+    // Operator for one zero bit, squared up to one zero byte
+    uint64_t bit_op[64], two_bits[64], four_bits[64];
+    bit_op[0] = poly;
+    for (int n = 1; n < 64; n++) {
+        bit_op[n] = 1ULL << (n - 1);
+    }
+    gf2_matrix_square(two_bits, bit_op);
+    gf2_matrix_square(four_bits, two_bits);
+    gf2_matrix_square(crc64_shift_ops[0], four_bits);
+    for (int k = 1; k < CRC64_SHIFT_LEVELS; k++) {
+        gf2_matrix_square(crc64_shift_ops[k], crc64_shift_ops[k - 1]);
+    }
+    
     crc64_initialized = 1;
 }
 
@@ -49,3 +86,17 @@ static inline uint64_t crc64_update(uint64_t crc, const unsigned char *data, siz
 uint64_t crc64_compute(const unsigned char *data, size_t len) {
     return crc64_update(0, data, len);
 }
+
+// Combine CRCs of adjacent pieces: crc64(A || B) from crc64(A), crc64(B), |B|
+uint64_t crc64_combine(uint64_t crc1, uint64_t crc2, size_t len2) {
+    crc64_init();
+    
+    // Advance crc1 over len2 zero bytes, one power of two at a time
+    for (int k = 0; len2 && k < CRC64_SHIFT_LEVELS; k++, len2 >>= 1) {
+        if (len2 & 1) {
+            crc1 = gf2_matrix_times(crc64_shift_ops[k], crc1);
+        }
+    }
+    
+    return crc1 ^ crc2;
+}
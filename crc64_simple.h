@@ -18,4 +18,7 @@ void crc64_init(void);
 // Compute CRC64 checksum for data
 uint64_t crc64_compute(const unsigned char *data, size_t len);
 
+// Combine CRC64 of two adjacent pieces (len2 = length of the second piece)
+uint64_t crc64_combine(uint64_t crc1, uint64_t crc2, size_t len2);
+
 #endif // CRC64_SIMPLE_H
@@ -0,0 +1,143 @@
+/*
+ * Host Information Implementation
+ */
+
+#define _GNU_SOURCE
+#include "host_info.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/utsname.h>
+
+// Copy at most size - 1 bytes and terminate
+static void copy_field(char *dest, size_t size, const char *src) {
+    snprintf(dest, size, "%s", src);
+}
+
+// "model name" from /proc/cpuinfo (x86), falling back to other architectures' keys
+static void read_cpu_model(HostInfo *info) {
+    FILE *file = fopen("/proc/cpuinfo", "r");
+    if (!file) {
+        return;
+    }
+    static const char *keys[] = {"model name", "Model", "cpu model", "Processor"};
+    char line[512];
+    int best = sizeof(keys) / sizeof(keys[0]);
+    while (fgets(line, sizeof(line), file)) {
+        char *colon = strchr(line, ':');
+        if (!colon) {
+            continue;
+        }
+        for (int k = 0; k < best; k++) {
+            if (strncmp(line, keys[k], strlen(keys[k])) != 0) {
+                continue;
+            }
+            char *value = colon + 1;
+            while (*value == ' ' || *value == '\t') {
+                value++;
+            }
+            value[strcspn(value, "\n")] = '\0';
+            if (*value) {
+                copy_field(info->cpu_model, sizeof(info->cpu_model), value);
+                best = k;
+            }
+            break;
+        }
+    }
+    fclose(file);
+}
+
+// Nominal frequency: cpufreq base (or max) frequency in kHz, else "cpu MHz"
+// from /proc/cpuinfo (what VMs without cpufreq usually expose)
+static void read_cpu_mhz(HostInfo *info) {
+    static const char *paths[] = {
+        "/sys/devices/system/cpu/cpu0/cpufreq/base_frequency",
+        "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq",
+    };
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        FILE *file = fopen(paths[i], "r");
+        if (!file) {
+            continue;
+        }
+        long khz = 0;
+        int ok = fscanf(file, "%ld", &khz) == 1 && khz > 0;
+        fclose(file);
+        if (ok) {
+            info->cpu_mhz = khz / 1000.0;
+            return;
+        }
+    }
+
+    FILE *file = fopen("/proc/cpuinfo", "r");
+    if (!file) {
+        return;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        char *colon = strchr(line, ':');
+        double mhz;
+        if (strncmp(line, "cpu MHz", 7) == 0 && colon && sscanf(colon + 1, "%lf", &mhz) == 1) {
+            info->cpu_mhz = mhz;
+            break;
+        }
+    }
+    fclose(file);
+}
+
+// Match the file's device number against /proc/self/mountinfo, whose lines read
+// "id parent major:minor root mount-point options [tags] - fstype source options"
+static void read_mount(HostInfo *info, const char *filename) {
+    struct stat st;
+    if (stat(filename, &st) != 0) {
+        return;
+    }
+    FILE *file = fopen("/proc/self/mountinfo", "r");
+    if (!file) {
+        return;
+    }
+    char line[4096];
+    while (fgets(line, sizeof(line), file)) {
+        unsigned major_id, minor_id;
+        char mount_point[256];
+        if (sscanf(line, "%*d %*d %u:%u %*s %255s", &major_id, &minor_id, mount_point) != 3) {
+            continue;
+        }
+        if (makedev(major_id, minor_id) != st.st_dev) {
+            continue;
+        }
+        char *separator = strstr(line, " - ");
+        char fs_type[64], source[256];
+        if (!separator || sscanf(separator + 3, "%63s %255s", fs_type, source) != 2) {
+            continue;
+        }
+        // Later entries shadow earlier ones for the same device
+        copy_field(info->fs_type, sizeof(info->fs_type), fs_type);
+        copy_field(info->fs_device, sizeof(info->fs_device), source);
+        copy_field(info->mount_point, sizeof(info->mount_point), mount_point);
+    }
+    fclose(file);
+}
+
+void host_info_collect(HostInfo *info, const char *filename) {
+    copy_field(info->cpu_model, sizeof(info->cpu_model), "unknown");
+    copy_field(info->kernel, sizeof(info->kernel), "unknown");
+    copy_field(info->hostname, sizeof(info->hostname), "unknown");
+    copy_field(info->fs_type, sizeof(info->fs_type), "unknown");
+    copy_field(info->fs_device, sizeof(info->fs_device), "unknown");
+    copy_field(info->mount_point, sizeof(info->mount_point), "unknown");
+
+    info->num_cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    info->cpu_mhz = 0.0;
+    read_cpu_model(info);
+    read_cpu_mhz(info);
+
+    struct utsname name;
+    if (uname(&name) == 0) {
+        snprintf(info->kernel, sizeof(info->kernel), "%s %s", name.release, name.version);
+        copy_field(info->hostname, sizeof(info->hostname), name.nodename);
+    }
+    read_mount(info, filename);
+}
@@ -0,0 +1,25 @@
+/*
+ * Host Information Header
+ *
+ * Describes the machine and the filesystem a benchmark ran on, so stored
+ * results can be compared across hosts and storage configurations
+ */
+
+#ifndef HOST_INFO_H
+#define HOST_INFO_H
+
+typedef struct {
+    char cpu_model[256];
+    int num_cpus;          // online logical CPUs
+    double cpu_mhz;        // nominal clock (0 when unknown), for cycles-per-byte estimates
+    char kernel[256];      // uname release and version
+    char hostname[256];
+    char fs_type[64];      // filesystem holding the benchmarked file
+    char fs_device[256];   // mount source of that filesystem
+    char mount_point[256];
+} HostInfo;
+
+// Fill in whatever can be discovered; unknown fields read "unknown"
+void host_info_collect(HostInfo *info, const char *filename);
+
+#endif // HOST_INFO_H
@@ -0,0 +1,85 @@
+/*
+ * Latency Histogram Implementation
+ */
+
+#include "latency_histogram.h"
+#include <string.h>
+
+// Values below LATENCY_SUB_BUCKETS map to themselves; larger ones to their
+// power of two and the LATENCY_SUB_BITS bits just below its leading bit
+static int bucket_index(uint64_t value) {
+    if (value < LATENCY_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int sub = (int)(value >> (msb - LATENCY_SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+    return (msb - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS + sub;
+}
+
+// Largest value that lands in a bucket
+static uint64_t bucket_upper(int index) {
+    if (index < LATENCY_SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+    int msb = index / LATENCY_SUB_BUCKETS + LATENCY_SUB_BITS - 1;
+    uint64_t sub = index % LATENCY_SUB_BUCKETS;
+    uint64_t width = 1ULL << (msb - LATENCY_SUB_BITS);
+    return (1ULL << msb) + sub * width + (width - 1);
+}
+
+void latency_histogram_reset(LatencyHistogram *hist) {
+    memset(hist, 0, sizeof(*hist));
+}
+
+void latency_histogram_record(LatencyHistogram *hist, uint64_t value) {
+    if (hist->count == 0 || value < hist->min) {
+        hist->min = value;
+    }
+    if (value > hist->max) {
+        hist->max = value;
+    }
+    hist->count++;
+    hist->sum += (double)value;
+    hist->buckets[bucket_index(value)]++;
+}
+
+void latency_histogram_merge(LatencyHistogram *dest, const LatencyHistogram *src) {
+    if (src->count == 0) {
+        return;
+    }
+    if (dest->count == 0 || src->min < dest->min) {
+        dest->min = src->min;
+    }
+    if (src->max > dest->max) {
+        dest->max = src->max;
+    }
+    dest->count += src->count;
+    dest->sum += src->sum;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        dest->buckets[i] += src->buckets[i];
+    }
+}
+
+uint64_t latency_histogram_percentile(const LatencyHistogram *hist, double p) {
+    if (hist->count == 0) {
+        return 0;
+    }
+    // Smallest bucket holding at least p% of the samples
+    uint64_t target = (uint64_t)(p / 100.0 * hist->count + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) {
+            uint64_t upper = bucket_upper(i);
+            return upper < hist->max ? upper : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+double latency_histogram_mean(const LatencyHistogram *hist) {
+    return hist->count > 0 ? hist->sum / hist->count : 0.0;
+}
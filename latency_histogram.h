@@ -0,0 +1,35 @@
+/*
+ * Latency Histogram Header
+ *
+ * Log-bucketed (HDR-style) histogram of nanosecond latencies: each power of
+ * two is split into LATENCY_SUB_BUCKETS linear buckets, so any recorded value
+ * is kept within 1/LATENCY_SUB_BUCKETS of its true value at a fixed size
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+#define LATENCY_SUB_BITS 5
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS ((64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+typedef struct {
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    double sum;
+    uint64_t buckets[LATENCY_BUCKETS];
+} LatencyHistogram;
+
+void latency_histogram_reset(LatencyHistogram *hist);
+void latency_histogram_record(LatencyHistogram *hist, uint64_t value);
+void latency_histogram_merge(LatencyHistogram *dest, const LatencyHistogram *src);
+
+// Highest value equivalent to the p-th percentile (0-100), capped at max;
+// 0 for an empty histogram
+uint64_t latency_histogram_percentile(const LatencyHistogram *hist, double p);
+double latency_histogram_mean(const LatencyHistogram *hist);
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,95 @@
+/*
+ * Page Cache Control Implementation
+ */
+
+#define _GNU_SOURCE
+#include "page_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Drop clean page cache, dentries and inodes system-wide (root only)
+static int drop_system_caches(void) {
+    sync();
+    FILE *file = fopen("/proc/sys/vm/drop_caches", "w");
+    if (!file) {
+        return 0;
+    }
+    int ok = fputs("3\n", file) >= 0;
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+int page_cache_evict(const char *filename, int drop_all, int *dropped_all) {
+    if (dropped_all) {
+        *dropped_all = 0;
+    }
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return 0;
+    }
+    // Dirty pages cannot be dropped, so flush them first
+    fdatasync(fd);
+    int ok = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+
+    if (drop_all && geteuid() == 0) {
+        int dropped = drop_system_caches();
+        if (dropped_all) {
+            *dropped_all = dropped;
+        }
+    }
+    return ok;
+}
+
+int page_cache_residency(const char *filename, size_t *resident_bytes, size_t *file_bytes) {
+    *resident_bytes = 0;
+    *file_bytes = 0;
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 0;
+    }
+    *file_bytes = st.st_size;
+    if (st.st_size == 0) {
+        close(fd);
+        return 1;
+    }
+
+    // Mapping without touching the pages does not change residency
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 0;
+    }
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t pages = (st.st_size + page_size - 1) / page_size;
+    unsigned char *vec = malloc(pages);
+    if (!vec) {
+        munmap(map, st.st_size);
+        return 0;
+    }
+    int ok = mincore(map, st.st_size, vec) == 0;
+    if (ok) {
+        size_t resident_pages = 0;
+        for (size_t i = 0; i < pages; i++) {
+            resident_pages += vec[i] & 1;
+        }
+        *resident_bytes = resident_pages * page_size;
+        if (*resident_bytes > *file_bytes) {
+            *resident_bytes = *file_bytes;  // last page is partial
+        }
+    }
+    free(vec);
+    munmap(map, st.st_size);
+    return ok;
+}
@@ -0,0 +1,22 @@
+/*
+ * Page Cache Control Header
+ *
+ * Evict a file from the page cache and measure how much of it is resident,
+ * so methods can be measured against storage instead of RAM
+ */
+
+#ifndef PAGE_CACHE_H
+#define PAGE_CACHE_H
+
+#include <stddef.h>
+
+// Ask the kernel to drop the file's cached pages (posix_fadvise DONTNEED).
+// With drop_all, also sync and write /proc/sys/vm/drop_caches, which needs
+// root; *dropped_all reports whether that succeeded. Returns 0 on failure.
+int page_cache_evict(const char *filename, int drop_all, int *dropped_all);
+
+// Count the file's pages that are in the page cache (mincore).
+// Returns 0 on failure.
+int page_cache_residency(const char *filename, size_t *resident_bytes, size_t *file_bytes);
+
+#endif // PAGE_CACHE_H
@@ -0,0 +1,179 @@
+/*
+ * Hardware Performance Counters Implementation
+ */
+
+#define _GNU_SOURCE
+#include "perf_counters.h"
+#include <linux/perf_event.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+
+static const struct {
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+} event_table[PERF_NUM_EVENTS] = {
+    {"cycles",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"LLC-misses",       PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"dTLB-misses",      PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"branch-misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"page-faults",      PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+const char *perf_event_name(PerfEvent event) {
+    return event < PERF_NUM_EVENTS ? event_table[event].name : "unknown";
+}
+
+static int open_event(PerfEvent event, pid_t tid, int group_fd, int user_only) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event_table[event].type;
+    attr.config = event_table[event].config;
+    attr.disabled = group_fd == -1;    // members follow their leader
+    attr.exclude_kernel = user_only;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, tid, -1, group_fd, 0);
+}
+
+// Thread ids from /proc/self/task
+static int list_threads(pid_t **tids) {
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir) {
+        return 0;
+    }
+    int count = 0, capacity = 0;
+    *tids = NULL;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+            continue;
+        }
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            pid_t *grown = realloc(*tids, capacity * sizeof(pid_t));
+            if (!grown) {
+                break;
+            }
+            *tids = grown;
+        }
+        (*tids)[count++] = (pid_t)atoi(entry->d_name);
+    }
+    closedir(dir);
+    return count;
+}
+
+int perf_counters_open(PerfCounters *counters) {
+    memset(counters, 0, sizeof(*counters));
+
+    // Counting kernel work needs perf_event_paranoid < 2 (or privileges)
+    int probe = open_event(PERF_PAGE_FAULTS, 0, -1, 0);
+    if (probe < 0 && (errno == EACCES || errno == EPERM)) {
+        counters->user_only = 1;
+        probe = open_event(PERF_PAGE_FAULTS, 0, -1, 1);
+    }
+    if (probe < 0) {
+        counters->open_errno = errno;
+        return 0;
+    }
+    close(probe);
+
+    pid_t *tids = NULL;
+    int num_threads = list_threads(&tids);
+    counters->fds = malloc(num_threads * sizeof(*counters->fds));
+    counters->leaders = malloc(num_threads * sizeof(int));
+    if (num_threads == 0 || !counters->fds || !counters->leaders) {
+        free(tids);
+        free(counters->fds);
+        free(counters->leaders);
+        counters->fds = NULL;
+        counters->leaders = NULL;
+        return 0;
+    }
+    counters->num_threads = num_threads;
+
+    for (int t = 0; t < num_threads; t++) {
+        int leader = -1;
+        for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+            int fd = open_event((PerfEvent)e, tids[t], leader, counters->user_only);
+            if (fd < 0 && !counters->open_errno) {
+                counters->open_errno = errno;
+            }
+            counters->fds[t][e] = fd;
+            if (fd >= 0) {
+                counters->available |= 1u << e;
+                if (leader == -1) {
+                    leader = fd;
+                }
+            }
+        }
+        counters->leaders[t] = leader;
+    }
+    free(tids);
+
+    int events = 0;
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        events += (counters->available >> e) & 1;
+    }
+    return events;
+}
+
+void perf_counters_close(PerfCounters *counters) {
+    for (int t = 0; t < counters->num_threads; t++) {
+        for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+            if (counters->fds[t][e] >= 0) {
+                close(counters->fds[t][e]);
+            }
+        }
+    }
+    free(counters->fds);
+    free(counters->leaders);
+    counters->fds = NULL;
+    counters->leaders = NULL;
+    counters->num_threads = 0;
+}
+
+void perf_counters_start(PerfCounters *counters) {
+    for (int t = 0; t < counters->num_threads; t++) {
+        if (counters->leaders[t] >= 0) {
+            ioctl(counters->leaders[t], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(counters->leaders[t], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+}
+
+void perf_counters_stop(PerfCounters *counters) {
+    for (int t = 0; t < counters->num_threads; t++) {
+        if (counters->leaders[t] >= 0) {
+            ioctl(counters->leaders[t], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+    memset(counters->values, 0, sizeof(counters->values));
+    for (int t = 0; t < counters->num_threads; t++) {
+        for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+            uint64_t data[3];   // value, time enabled, time running
+            if (counters->fds[t][e] < 0 ||
+                read(counters->fds[t][e], data, sizeof(data)) != sizeof(data)) {
+                continue;
+            }
+            // Scale up if the group was multiplexed off the PMU part of the time
+            if (data[2] > 0 && data[2] < data[1]) {
+                data[0] = (uint64_t)((double)data[0] * data[1] / data[2]);
+            }
+            counters->values[e] += data[0];
+        }
+    }
+}
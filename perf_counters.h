@@ -0,0 +1,47 @@
+/*
+ * Hardware Performance Counters Header
+ *
+ * perf_event_open counters for every thread of this process, grouped per
+ * thread so they are scheduled together; events the kernel, hypervisor or
+ * perf_event_paranoid refuse are simply left out
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_PAGE_FAULTS,
+    PERF_CONTEXT_SWITCHES,
+    PERF_NUM_EVENTS
+} PerfEvent;
+
+typedef struct {
+    int num_threads;
+    int (*fds)[PERF_NUM_EVENTS];   // per thread, -1 where the event did not open
+    int *leaders;                  // per-thread group leader fd
+    unsigned available;            // bit per event opened on at least one thread
+    int user_only;                 // kernel-side counting was refused
+    int open_errno;                // first failure, for diagnostics
+    uint64_t values[PERF_NUM_EVENTS];  // totals across threads after stop
+} PerfCounters;
+
+// Open counters on every current thread of the process (returns the number
+// of events available, 0 when perf is not permitted or not supported)
+int perf_counters_open(PerfCounters *counters);
+void perf_counters_close(PerfCounters *counters);
+
+// Reset and enable all groups; disable them and sum the counts (scaled for
+// multiplexing) into values
+void perf_counters_start(PerfCounters *counters);
+void perf_counters_stop(PerfCounters *counters);
+
+const char *perf_event_name(PerfEvent event);
+
+#endif // PERF_COUNTERS_H
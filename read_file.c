@@ -9,18 +9,32 @@
  * Uses CRC64 with XOR for order-independent hashing
  */
 
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <time.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdint.h>
+#include <limits.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include "crc64_simple.h"
+#include "cpu_topology.h"
+#include "bench_session.h"
+#include "uring_simple.h"
+#include "bench_stats.h"
+#include "page_cache.h"
+#include "host_info.h"
+#include "perf_counters.h"
+#include "resource_usage.h"
+#include "latency_histogram.h"
+#include "trace_events.h"
+#include "result_file.h"
     
 typedef char* String;
 
@@ -30,59 +44,700 @@ typedef char* String;
 #define MAX_QUEUE_SIZE 16  // Buffer queue capacity
 #define NUM_READERS 4      // Parallel reader threads
 #define NUM_CONSUMERS 4    // Parallel processor threads
+#define NUM_WORKERS 8      // Fused read+hash threads (work-stealing)
+#define MAX_READERS 16     // Reader threads available to the auto-tuner
+#define MAX_CONSUMERS 16   // Consumer threads available to the auto-tuner
+#define MAX_QUEUE_LANES 16 // Async queue lanes: one per smt pair or compact node
+#define TUNE_INTERVAL_MS 250  // Auto-tuner sampling period
+#define TUNE_COOLDOWN 4       // Intervals to hold after a reverted move
+#define REORDER_WINDOW 8      // Ordered pipeline lookahead (blocks)
+#define URING_QUEUE_DEPTH 4   // Block reads in flight for the event-loop engine
+#define MAX_WORKERS 32        // Upper bounds for per-method overrides (--methods)
+#define MAX_REORDER_WINDOW 32
+#define MAX_URING_DEPTH 32
+#define MAX_SELECTED 256      // Method runs in the run list (--sweep multiplies --methods)
+#define MAX_BLOCK_SIZE (1024 * 1024 * 1024)
+#define IOPS_IO_SIZE (8 * 1024)       // Random IOPS defaults: read size, total reads,
+#define IOPS_OPS 20000                // threads and reads in flight per thread
+#define IOPS_WORKERS 4
+#define IOPS_QUEUE_DEPTH 16
+#define IOPS_MIN_IO (4 * 1024)        // Read sizes: multiples of 4K, so O_DIRECT stays aligned
+#define IOPS_MAX_IO (1024 * 1024)
+#define IOPS_ALIGNMENT 4096
+#define MAX_IOPS_OPS 1000000000
+#define SLICE_ALIGNMENT 4096  // Async slices shrunk to fit --max-inflight-bytes stay page multiples
+#define SWEEP_MIN_BLOCK (4 * 1024)           // Default --sweep range, doubling each step
+#define SWEEP_MAX_BLOCK (256 * 1024 * 1024)
+#define MAX_SWEEP_SIZES 32
+#define SWEEP_KNEE 0.9        // Knee: smallest block reaching this share of the peak
+#define COLD_RESIDENCY 0.05   // Runs starting with less of the file cached are "cold"
+#define WARM_RESIDENCY 0.95   // ... and with more, "warm"; anything between is "partial"
+#define DEVICE_BOUND_SHARE 0.5   // Verdicts: idle time is I/O once this share came from the device
+#define CALIBRATE_SECONDS 0.1    // Hash-rate calibration when no memhash ran at a block size
+#define CALIBRATE_MAX_BYTES (64 * 1024 * 1024)
+#define TRACE_MAX_EVENTS (1 << 20)  // Spans kept per thread for --trace
+#define MIN_SAMPLE_MS 10
+#define COMPARE_RESAMPLES 10000  // Bootstrap resamples per method (--compare)
+#define COMPARE_CONFIDENCE 95.0
+#define COMPARE_SEED 0x5EEDULL   // Fixed, so a comparison always prints the same CI
+#define EXIT_REGRESSION 2
+
+// Session buffer cap: the auto-tuner's async maximum, which also covers the
+// largest work-stealing, reorder-window and io_uring overrides
+#define MAX_SESSION_BUFFERS (MAX_READERS + MAX_QUEUE_SIZE + MAX_CONSUMERS)
 
 
 // Verbosity levels: 0=times only, 1=times+checksums, 2=debug output
+// (-1 is used internally to run warmups and repetitions silently)
 int verbosity = 1;
 
+// Timed runs per method (--repeat), untimed runs before them (--warmup),
+// and whether to list every sample in the summary (--samples)
+int repeat_count = 1;
+int warmup_count = 0;
+int print_samples = 0;
+
+// Method scheduling across repetitions (--order): each method's runs back
+// to back, a fresh seeded shuffle per round, or round-robin
+typedef enum {
+    ORDER_FIXED,
+    ORDER_SHUFFLE,
+    ORDER_INTERLEAVE
+} ScheduleOrder;
+
+ScheduleOrder schedule_order = ORDER_FIXED;
+uint64_t schedule_seed = 0;  // --seed, otherwise picked at startup
+
+// Block order of the random and alternating methods
+typedef enum {
+    ACCESS_ALTERNATING,   // from both ends toward the centre
+    ACCESS_PERMUTED       // seeded Fisher-Yates permutation
+} AccessPattern;
+
+uint64_t access_seed = 0;    // --access-seed, otherwise picked at startup
+
+// Machine-readable results (--format), written to --output or stdout
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_CSV
+} OutputFormat;
+
+OutputFormat output_format = FORMAT_TEXT;
+const char *output_path = NULL;
+
+// Hardware/software counters around every timed region (--perf); open
+// only while a method runs
+int perf_enabled = 0;
+static PerfCounters perf_counters;
+static int perf_active = 0;
+
+// Per-block latency histograms for the read, queue-wait and hash phases (--latency)
+int latency_enabled = 0;
+
+// Background sampler: throughput, read-ahead depth and busy threads every
+// sample_ms during each run, as a live line on a terminal and/or as rows of
+// a CSV time series (--sample-ms, --timeseries FILE, --no-progress)
+int sample_ms = 200;
+const char *timeseries_path = NULL;
+int show_progress = 1;
+static FILE *timeseries_file = NULL;
+
+// Run every selected method at each power-of-two block size in the range (--sweep,
+// --sweep-range); the run list is expanded base-major, size-minor
+int sweep_enabled = 0;
+size_t sweep_min = SWEEP_MIN_BLOCK;
+size_t sweep_max = SWEEP_MAX_BLOCK;
+static size_t sweep_sizes[MAX_SWEEP_SIZES];
+static int num_sweep_sizes = 0;
+static char sweep_labels[MAX_SELECTED][96];   // labels before expansion
+
+// Compare two result files instead of benchmarking (--compare BASE CAND):
+// a method regresses when the candidate is slower with p < compare_alpha
+// and by more than compare_min_change percent
+const char *compare_baseline = NULL;
+const char *compare_candidate = NULL;
+double compare_alpha = 0.05;
+double compare_min_change = 2.0;
+
+// Chrome trace of every thread's spans (--trace FILE)
+const char *trace_path = NULL;
+static TraceLog trace_log;
+static int tracing = 0;
+
+// Evict the file from the page cache before every run (--cold), and also
+// drop the system-wide caches when running as root (--drop-caches)
+int cold_cache = 0;
+int drop_caches = 0;
+
+// Thread placement policy (--pin) and the topology it is applied to
+PinPolicy pin_policy = PIN_NONE;
+static CpuTopology topology;
+
+// Adjust the async reader/consumer split while running (--auto-tune)
+int auto_tune = 0;
+
+// Async readers publish each block in slices of this size (--chunk-size, 0 = whole blocks)
+size_t chunk_size = 0;
+
+// Ceiling on bytes the async pipeline holds at once (--max-inflight-bytes, 0 = unlimited)
+size_t max_inflight_bytes = 0;
+
+// Per-block phases timed with --latency
+typedef enum {
+    PHASE_READ,        // one read call, or io_uring submission to completion
+    PHASE_QUEUE_WAIT,  // blocked on a pipeline queue or the reorder window
+    PHASE_HASH,        // CRC of one block or slice
+    PHASE_COUNT
+} Phase;
+
+static const char *phase_names[PHASE_COUNT] = {"read", "queue_wait", "hash"};
+
+// Page-cache state of the file when a run started
+typedef enum {
+    CACHE_COLD,
+    CACHE_PARTIAL,
+    CACHE_WARM,
+    CACHE_STATE_COUNT
+} CacheState;
+
+static const char *cache_state_names[CACHE_STATE_COUNT] = {"cold", "partial", "warm"};
+
+// Tail of one phase's latencies over a run, in nanoseconds
+typedef struct {
+    uint64_t count;
+    double mean;
+    uint64_t p50, p90, p99, p999, max;
+} PhaseLatency;
+
+// Outcome of one run of a reading method
+typedef struct {
+    int ok;              // set once the method has read the whole file
+    uint64_t hash;
+    int unhashed;        // the memcpy baseline copies without hashing: no hash to report
+    size_t total_bytes;
+    double seconds;
+    double resident_fraction;  // share of the file in page cache when the run started
+    CacheState cache;          // resident_fraction against COLD_/WARM_RESIDENCY
+    size_t block_size;
+    int readers;               // threads issuing reads
+    int consumers;             // threads hashing
+    int threads;               // distinct threads (fused methods read and hash on one)
+    double cpu_seconds;        // process CPU time over the timed region
+    double main_cpu_seconds;   // CPU time of the thread running the method
+    double worker_cpu_seconds; // CPU time of the method's pool tasks
+    struct timespec process_cpu_start;  // CPU clocks when timing started
+    struct timespec thread_cpu_start;
+    unsigned perf_available;            // bit per PerfEvent counted (--perf)
+    uint64_t perf_values[PERF_NUM_EVENTS];
+    ResourceUsage usage_start;          // faults, switches and I/O when timing started
+    ResourceUsage usage;                // ...and what the timed region added
+    PhaseLatency latency[PHASE_COUNT];  // per-block latencies (--latency)
+    size_t ops;                         // random IOPS: reads completed
+    PhaseLatency op_latency;            // ...and their submission-to-completion latency
+} MethodResult;
+
+// Tunables of one method run; defaults come from the constants above and
+// can be overridden per method with --methods key:name=value
+typedef struct {
+    size_t block_size;
+    int readers;       // async, ordered
+    int consumers;     // async
+    int workers;       // work-stealing
+    int window;        // ordered reorder window (blocks)
+    int queue_depth;   // event-loop io_uring depth, random IOPS depth per thread
+    size_t ops;        // random IOPS: total reads
+    int direct;        // random IOPS: open with O_DIRECT
+} MethodParams;
+
 // Buffer node for producer-consumer queue
 typedef struct BufferNode {
     unsigned char *data;
     size_t size;
+    int node;           // NUMA node of the reader that produced the block
+    size_t tail_bytes;  // bytes after this slice in its block (chunked mode)
+    size_t reserved;    // budget held by this slice's buffer until it is hashed
     struct BufferNode *next;
 } BufferNode;
 
-// Thread-safe queue for async processing
+// Byte budget every async buffer is charged to: a reader's staging buffer
+// for the reader's lifetime, a queued copy until it has been hashed
+typedef struct {
+    size_t limit;       // SIZE_MAX when unlimited
+    size_t used;
+    size_t peak;
+    pthread_mutex_t mutex;
+    pthread_cond_t released;
+} ByteBudget;
+
+// Thread-safe queue for async processing. Under smt and compact pinning it
+// splits into lanes (one per reader/consumer pair or per node), so a slice
+// is hashed next to where it was read unless its own lane's consumers fall
+// behind; otherwise there is one lane, a plain FIFO.
 typedef struct {
-    BufferNode *head;
-    BufferNode *tail;
-    int count;
+    BenchSession *session;  // supplies node buffers and reader buffers
+    BufferNode *head[MAX_QUEUE_LANES];
+    BufferNode *tail[MAX_QUEUE_LANES];
+    int lanes;
+    size_t foreign_slices;  // slices a consumer took from another lane
+    int count;              // across all lanes
     pthread_mutex_t mutex;
     sem_t empty_slots;  // Available queue capacity
     sem_t full_slots;   // Available items to process
     int reading_done;
     int active_readers;
-    size_t total_blocks;   // total number of BLOCK_SIZE-aligned blocks
+    size_t total_blocks;   // total number of block-aligned blocks
     size_t next_block;     // next block index to assign to a reader
     size_t file_size;      // file size for last block size calculation
+    size_t block_size;
+    size_t slice_size;     // bytes read and queued at a time (and every buffer's size)
+    size_t node_bytes[TOPOLOGY_MAX_NODES];  // bytes hashed per consumer node
+    size_t slices_hashed;
+    size_t cross_node_slices;              // slices hashed on a remote node
+    size_t bytes_hashed;   // running total sampled by the auto-tuner
+    int reader_limit;      // readers with id >= limit stay parked
+    int consumer_limit;    // consumers with id >= limit stay parked
+    pthread_cond_t tune_cond;  // wakes parked threads when limits change
+    struct timespec start_time;  // when readers were started
+    double first_hash_time;      // seconds until the first hash completed (< 0 = none yet)
+    ByteBudget budget;           // caps bytes held in pipeline buffers
 } BufferQueue;
 
+// Auto-tuner adjustments (hill-climbing moves)
+typedef enum {
+    TUNE_NONE,
+    TUNE_ADD_READER,
+    TUNE_PARK_READER,
+    TUNE_ADD_CONSUMER,
+    TUNE_PARK_CONSUMER
+} TuneAction;
+
+// Holds a method's threads between their setup and the timed region
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    int ready;                 // threads done with setup
+    int open;                  // timing has started
+    double setup_cpu_seconds;  // thread CPU the threads spent on setup
+} StartGate;
+
 // Arguments passed to reader threads
 typedef struct {
     String filename;
     BufferQueue *queue;
+    StartGate *gate;
     size_t start_offset;
     size_t end_offset;
     int reader_id;
 } ReaderArgs;
 
+// Arguments passed to consumer threads
+typedef struct {
+    BufferQueue *queue;
+    int consumer_id;
+} ConsumerArgs;
+
+// Block range owned by one work-stealing worker. The owner claims blocks
+// from the front, thieves take the back half of whatever is left.
+typedef struct {
+    pthread_mutex_t mutex;
+    size_t next_block;   // next block index the owner will read
+    size_t end_block;    // one past the last block in the range
+} WorkRange;
+
+// Arguments passed to work-stealing worker threads
+typedef struct {
+    String filename;
+    BenchSession *session;
+    StartGate *gate;
+    WorkRange *ranges;     // one range per worker, shared by all workers
+    int num_workers;
+    int worker_id;
+    size_t file_size;
+    size_t block_size;
+    uint64_t hash_xor;     // worker-local XOR, merged after join
+    size_t total_bytes;
+    size_t steals;
+    int node;              // NUMA node the worker ran on
+} WorkerArgs;
+
+// Reorder buffer: readers fill slots by block index (bounded lookahead),
+// a single consumer drains them strictly in file order
+typedef struct {
+    unsigned char *slot_data[MAX_REORDER_WINDOW];  // slot for block i is i % window
+    size_t slot_size[MAX_REORDER_WINDOW];
+    int slot_ready[MAX_REORDER_WINDOW];
+    int window;            // slots in use
+    size_t block_size;
+    size_t next_claim;     // next block index handed to a reader
+    size_t next_deliver;   // next block index the consumer expects
+    size_t total_blocks;
+    size_t file_size;
+    int failed;            // a reader hit an I/O error
+    pthread_mutex_t mutex;
+    pthread_cond_t window_advanced;  // readers may claim further
+    pthread_cond_t block_landed;     // a block was buffered
+    size_t stalls;              // consumer waits with later blocks already buffered
+    double stall_seconds;
+    int peak_buffered;          // most blocks waiting at once
+} ReorderBuffer;
+
+// One in-flight block of the single-threaded event-loop engine
+typedef struct {
+    unsigned char *buffer;
+    size_t block_index;
+    size_t offset;     // file offset of the block
+    size_t expected;   // block length
+    size_t done;       // bytes landed so far (reads may complete short)
+    uint64_t read_start;  // span_begin() when the block was first queued
+} UringSlot;
+
+// Arguments passed to random IOPS threads
+typedef struct {
+    String filename;
+    StartGate *gate;
+    int worker_id;
+    size_t file_size;
+    size_t io_size;
+    size_t ops;            // reads this thread issues
+    int queue_depth;
+    int direct;
+    uint64_t seed;         // offsets are drawn from stats_random
+    uint64_t hash_xor;     // thread-local XOR, merged after join
+    size_t total_bytes;
+    size_t completed;
+    int error;             // errno of the first failure
+    int no_uring;          // fell back to one pread at a time
+    int node;
+    LatencyHistogram latency;   // submission to completion of every read
+} IopsArgs;
+
+// Arguments passed to ordered pipeline reader threads
+typedef struct {
+    String filename;
+    ReorderBuffer *rob;
+    StartGate *gate;
+    int reader_id;
+} OrderedReaderArgs;
+
+// Host description, and its nominal clock for cycles-per-byte estimates
+static HostInfo host_info;
+static double cpu_hz = 0.0;
+
 // Global state
 static uint64_t global_hash_xor = 0;  // XOR allows order-independent hashing
 static pthread_mutex_t hash_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-// High-resolution timing utilities
+// High-resolution timing utilities (monotonic, so NTP cannot slew a measurement)
 static inline struct timespec timer_start() {
     struct timespec start;
-    clock_gettime(CLOCK_REALTIME, &start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
     return start;
 }
 
-static inline void timer_end_print(const char *label, struct timespec start) {
+static inline double timer_elapsed(struct timespec start) {
     struct timespec end;
-    clock_gettime(CLOCK_REALTIME, &end);
-    double time_taken = (end.tv_sec - start.tv_sec) +
-                        (end.tv_nsec - start.tv_nsec) / 1e9;
-    printf("%s: %f seconds\n", label, time_taken);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) +
+           (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static inline double timespec_diff(struct timespec end, struct timespec start) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// What instrumented code is doing. Each span feeds a latency phase (--latency)
+// and/or a slice on its thread's track in the trace (--trace).
+typedef enum {
+    SPAN_CLAIM,          // taking the next block index
+    SPAN_STEAL,          // work-stealing worker taking blocks from another range
+    SPAN_READ,           // one read call
+    SPAN_URING_READ,     // io_uring submission to completion
+    SPAN_URING_WAIT,     // blocked reaping an io_uring completion
+    SPAN_ENQUEUE_WAIT,   // reader blocked on a full queue
+    SPAN_DEQUEUE_WAIT,   // consumer blocked on an empty queue
+    SPAN_WINDOW_WAIT,    // ordered reader blocked on the reorder window
+    SPAN_REORDER_WAIT,   // ordered consumer waiting for the next block in order
+    SPAN_HASH,           // CRC of one block or slice
+    SPAN_LOCK_WAIT,      // contended mutex
+    SPAN_COUNT
+} Span;
+
+static const struct {
+    const char *name;
+    const char *category;
+    int phase;     // latency phase fed, or -1
+    int traced;    // in-flight io_uring reads overlap, so they are not slices
+} span_table[SPAN_COUNT] = {
+    {"claim",         "sync", -1,               1},
+    {"steal",         "sync", -1,               1},
+    {"read",          "io",   PHASE_READ,       1},
+    {"uring read",    "io",   PHASE_READ,       0},
+    {"uring wait",    "io",   -1,               1},
+    {"enqueue wait",  "wait", PHASE_QUEUE_WAIT, 1},
+    {"dequeue wait",  "wait", PHASE_QUEUE_WAIT, 1},
+    {"window wait",   "wait", PHASE_QUEUE_WAIT, 1},
+    {"reorder wait",  "wait", PHASE_QUEUE_WAIT, 1},
+    {"hash",          "cpu",  PHASE_HASH,       1},
+    {"lock wait",     "sync", -1,               1},
+};
+
+// Each thread records phases into its own histograms, merged between runs
+typedef struct PhaseRecorder {
+    LatencyHistogram phases[PHASE_COUNT];
+    struct PhaseRecorder *next;
+} PhaseRecorder;
+
+static __thread PhaseRecorder *thread_recorder = NULL;
+static PhaseRecorder *phase_recorders = NULL;
+static pthread_mutex_t recorders_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// ...and its spans into its own trace buffer
+static __thread TraceThread *thread_trace = NULL;
+static pthread_t main_thread;
+static int traced_threads = 0;
+
+static inline uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+// Timestamp a span start (0, and nothing recorded, without --latency or --trace)
+static inline uint64_t span_begin(void) {
+    return latency_enabled || tracing ? now_ns() : 0;
+}
+
+// Slice on the calling thread's trace track; names must outlive the trace
+static void trace_span(const char *name, const char *category, uint64_t start, uint64_t end) {
+    if (!thread_trace) {
+        char thread_name[32];
+        if (pthread_equal(pthread_self(), main_thread)) {
+            snprintf(thread_name, sizeof(thread_name), "main");
+        } else {
+            snprintf(thread_name, sizeof(thread_name), "pool worker %d",
+                     __sync_fetch_and_add(&traced_threads, 1));
+        }
+        thread_trace = trace_log_thread(&trace_log, (int)gettid(), thread_name);
+        if (!thread_trace) {
+            return;
+        }
+    }
+    trace_thread_add(thread_trace, name, category, start, end);
+}
+
+static void span_end(Span span, uint64_t start) {
+    if (!latency_enabled && !tracing) {
+        return;
+    }
+    uint64_t end = now_ns();
+    int phase = span_table[span].phase;
+    if (latency_enabled && phase >= 0) {
+        if (!thread_recorder) {
+            PhaseRecorder *recorder = calloc(1, sizeof(PhaseRecorder));
+            if (!recorder) {
+                return;
+            }
+            pthread_mutex_lock(&recorders_mutex);
+            recorder->next = phase_recorders;
+            phase_recorders = recorder;
+            pthread_mutex_unlock(&recorders_mutex);
+            thread_recorder = recorder;
+        }
+        latency_histogram_record(&thread_recorder->phases[phase], end - start);
+    }
+    if (tracing && span_table[span].traced) {
+        trace_span(span_table[span].name, span_table[span].category, start, end);
+    }
+}
+
+// pthread_mutex_lock that shows contended waits in the trace
+static inline void lock_mutex(pthread_mutex_t *mutex) {
+    if (!tracing) {
+        pthread_mutex_lock(mutex);
+        return;
+    }
+    if (pthread_mutex_trylock(mutex) == 0) {
+        return;
+    }
+    uint64_t start = now_ns();
+    pthread_mutex_lock(mutex);
+    span_end(SPAN_LOCK_WAIT, start);
+}
+
+// Progress of the running method, published for the sampler thread
+static int sampling = 0;
+static size_t progress_bytes = 0;   // hashed so far
+static int progress_depth = -1;     // blocks read but not yet hashed (-1: not pipelined)
+
+// Sampler of the running method; stopped as its timed region ends, so the
+// live line is gone before the result is printed
+typedef struct Sampler Sampler;
+static Sampler *active_sampler = NULL;
+static void sampler_stop(Sampler *sampler);
+
+static inline void progress_add(size_t bytes) {
+    if (sampling) {
+        __atomic_fetch_add(&progress_bytes, bytes, __ATOMIC_RELAXED);
+    }
+}
+
+static inline void progress_set_depth(int depth) {
+    if (sampling) {
+        __atomic_store_n(&progress_depth, depth, __ATOMIC_RELAXED);
+    }
+}
+
+// Merge every thread's histograms into out[PHASE_COUNT] and reset them;
+// only called while no method is running
+static void phase_collect(LatencyHistogram *out) {
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        latency_histogram_reset(&out[p]);
+    }
+    pthread_mutex_lock(&recorders_mutex);
+    for (PhaseRecorder *recorder = phase_recorders; recorder; recorder = recorder->next) {
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            latency_histogram_merge(&out[p], &recorder->phases[p]);
+            latency_histogram_reset(&recorder->phases[p]);
+        }
+    }
+    pthread_mutex_unlock(&recorders_mutex);
+}
+
+static void phase_free_recorders(void) {
+    pthread_mutex_lock(&recorders_mutex);
+    while (phase_recorders) {
+        PhaseRecorder *next = phase_recorders->next;
+        free(phase_recorders);
+        phase_recorders = next;
+    }
+    pthread_mutex_unlock(&recorders_mutex);
+}
+
+static void phase_summarize(const LatencyHistogram *hist, PhaseLatency *latency) {
+    latency->count = hist->count;
+    latency->mean = latency_histogram_mean(hist);
+    latency->p50 = latency_histogram_percentile(hist, 50.0);
+    latency->p90 = latency_histogram_percentile(hist, 90.0);
+    latency->p99 = latency_histogram_percentile(hist, 99.0);
+    latency->p999 = latency_histogram_percentile(hist, 99.9);
+    latency->max = hist->max;
+}
+
+// One line per phase that saw blocks, in microseconds
+static void print_phase_latency(const char *indent, const char *label, const PhaseLatency *latency) {
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        const PhaseLatency *l = &latency[p];
+        if (l->count == 0) {
+            continue;
+        }
+        printf("%s%s%-10s %8llu  mean %10.1f  p50 %10.1f  p90 %10.1f  p99 %10.1f  p99.9 %10.1f  max %10.1f us\n",
+               indent, label, phase_names[p], (unsigned long long)l->count, l->mean / 1e3,
+               l->p50 / 1e3, l->p90 / 1e3, l->p99 / 1e3, l->p999 / 1e3, l->max / 1e3);
+    }
+}
+
+// Snapshot resource usage, start the counters and sample the CPU clocks just
+// before a method's wall-clock timer starts, so none of it is timed...
+static inline void cpu_timer_start(MethodResult *result) {
+    resource_usage_snapshot(&result->usage_start);
+    if (perf_active) {
+        perf_counters_start(&perf_counters);
+    }
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &result->process_cpu_start);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &result->thread_cpu_start);
+}
+
+// ...and undo it in reverse once the wall clock has stopped
+// (worker_cpu_seconds comes from the method's task groups)
+static inline void cpu_timer_stop(MethodResult *result) {
+    if (perf_active) {
+        perf_counters_stop(&perf_counters);
+        result->perf_available = perf_counters.available;
+        memcpy(result->perf_values, perf_counters.values, sizeof(result->perf_values));
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    result->cpu_seconds = timespec_diff(now, result->process_cpu_start);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    result->main_cpu_seconds = timespec_diff(now, result->thread_cpu_start);
+    ResourceUsage end;
+    resource_usage_snapshot(&end);
+    resource_usage_delta(&result->usage_start, &end, &result->usage);
+    if (active_sampler) {
+        sampler_stop(active_sampler);
+    }
+}
+
+static double result_perf_per_byte(const MethodResult *result, PerfEvent event) {
+    return result->total_bytes > 0 ? (double)result->perf_values[event] / result->total_bytes : 0.0;
+}
+
+// Counter values per byte hashed ("n/a" where the event could not be opened)
+static void print_perf_counters(const MethodResult *result) {
+    if (verbosity < 1 || !result->perf_available) {
+        return;
+    }
+    printf("  Per byte:");
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        if (result->perf_available & (1u << e)) {
+            printf(" %s %.4g", perf_event_name((PerfEvent)e), result_perf_per_byte(result, e));
+        } else {
+            printf(" %s n/a", perf_event_name((PerfEvent)e));
+        }
+    }
+    unsigned ipc_events = (1u << PERF_CYCLES) | (1u << PERF_INSTRUCTIONS);
+    if ((result->perf_available & ipc_events) == ipc_events && result->perf_values[PERF_CYCLES] > 0) {
+        printf(", IPC %.2f", (double)result->perf_values[PERF_INSTRUCTIONS] /
+                             result->perf_values[PERF_CYCLES]);
+    }
+    printf("\n");
+}
+
+// CPU-seconds burned per GB hashed
+static double result_cpu_per_gb(const MethodResult *result) {
+    return result->total_bytes > 0 ? result->cpu_seconds / (result->total_bytes / 1e9) : 0.0;
+}
+
+// CPU time at the nominal clock per byte (0 when the clock is unknown)
+static double result_cycles_per_byte(const MethodResult *result) {
+    return result->total_bytes > 0 ? result->cpu_seconds * cpu_hz / result->total_bytes : 0.0;
+}
+
+static void print_cpu_usage(const MethodResult *result) {
+    if (verbosity < 1) {
+        return;
+    }
+    printf("  CPU: %f seconds (main %f, workers %f), %.3f CPU-s/GB",
+           result->cpu_seconds, result->main_cpu_seconds, result->worker_cpu_seconds,
+           result_cpu_per_gb(result));
+    if (cpu_hz > 0) {
+        printf(", %.2f cycles/byte", result_cycles_per_byte(result));
+    }
+    printf("\n");
+}
+
+// Faults and context switches, and whether the device was actually read
+// (read_bytes) or the page cache served everything (rchar only)
+static void print_os_usage(const MethodResult *result) {
+    if (verbosity < 1) {
+        return;
+    }
+    const ResourceUsage *usage = &result->usage;
+    printf("  OS: faults %ld minor / %ld major, switches %ld voluntary / %ld involuntary",
+           usage->minor_faults, usage->major_faults,
+           usage->voluntary_switches, usage->involuntary_switches);
+    if (usage->have_io) {
+        printf(", device %.1f MB, read() %.1f MB in %llu calls",
+               usage->read_bytes / 1e6, usage->rchar / 1e6, (unsigned long long)usage->syscr);
+    }
+    printf("\n");
+}
+
+static inline void timer_end_print(const char *label, double seconds) {
+    if (verbosity >= 0) {
+        printf("%s: %f seconds\n", label, seconds);
+    }
 }
 
 // File size validation and error handling
@@ -119,23 +774,56 @@ static void setup_hashing(void) {
 }
 
 // Common output for all reading functions
-static void print_results(const char *method_name, uint64_t hash, size_t total_bytes, struct timespec start_time) {
-    if (verbosity >= 1) {
+// A run counts only when it hashed every byte it set out to (the whole file,
+// or every read of an IOPS run); a short one is reported but left out
+static void result_check_complete(MethodResult *result, size_t expected_bytes) {
+    result->ok = result->total_bytes == expected_bytes;
+    if (!result->ok && verbosity >= 0) {
+        printf("  Incomplete: hashed %zu of %zu bytes, run not counted\n",
+               result->total_bytes, expected_bytes);
+    }
+}
+
+static void print_results(const char *method_name, uint64_t hash, size_t total_bytes,
+                          size_t expected_bytes, struct timespec start_time, MethodResult *result) {
+    result->seconds = timer_elapsed(start_time);
+    cpu_timer_stop(result);
+    result->hash = hash;
+    result->total_bytes = total_bytes;
+    
+    if (verbosity >= 1 && !result->unhashed) {
         printf("Hash (XOR): %016llx\n", (unsigned long long)hash);
     }
     if (verbosity >= 2) {
         printf("Total bytes processed: %zu\n", total_bytes);
     }
     
-    timer_end_print(method_name, start_time);
+    timer_end_print(method_name, result->seconds);
+    result_check_complete(result, expected_bytes);
+    print_cpu_usage(result);
+    print_os_usage(result);
+    print_perf_counters(result);
 }
 
 // Process a single block and update XOR of per-block CRCs (order-independent)
 static inline void process_block_xor(const unsigned char *data, size_t size, uint64_t *hash_xor) {
+    uint64_t start = span_begin();
     uint64_t block_hash = crc64_compute(data, size);
+    span_end(SPAN_HASH, start);
+    progress_add(size);
     *hash_xor ^= block_hash;
 }
 
+// fread of one block, timed as PHASE_READ
+static inline size_t read_block(void *buffer, size_t size, FILE *file) {
+    uint64_t start = span_begin();
+    size_t bytes_read = fread(buffer, 1, size, file);
+    if (bytes_read > 0) {
+        span_end(SPAN_READ, start);
+    }
+    return bytes_read;
+}
+
 // Memory-mapped file operations
 static void* map_file(const char *filename, size_t *file_size) {
     int fd = open(filename, O_RDONLY);
@@ -185,15 +873,171 @@ static void unmap_file(void *mapped_file, size_t file_size) {
     munmap(mapped_file, file_size);
 }
 
+// Pin the calling thread to its placement slot and return its NUMA node
+static int place_thread(int slot) {
+    if (pin_policy != PIN_NONE) {
+        int cpu = topology_cpu_for_slot(&topology, pin_policy, slot);
+        if (!topology_pin_self(cpu) && verbosity >= 2) {
+            fprintf(stderr, "Warning: Cannot pin slot %d to CPU %d\n", slot, cpu);
+        }
+    }
+    return topology_node_of(&topology, -1);
+}
+
+// Thread-private working buffer: a pre-faulted session buffer, or when pinned
+// a fresh one touched by the pinned thread so first-touch places it on the
+// thread's own node (session buffers were faulted by the main thread)
+static unsigned char *acquire_thread_buffer(BenchSession *session, size_t size) {
+    if (pin_policy == PIN_NONE) {
+        return buffer_pool_acquire(&session->buffers);
+    }
+    unsigned char *buffer = malloc(size);
+    if (buffer) {
+        memset(buffer, 0, size);
+    }
+    return buffer;
+}
+
+static void release_thread_buffer(BenchSession *session, unsigned char *buffer) {
+    if (pin_policy == PIN_NONE) {
+        buffer_pool_release(&session->buffers, buffer);
+    } else {
+        free(buffer);
+    }
+}
+
+static void start_gate_init(StartGate *gate) {
+    memset(gate, 0, sizeof(*gate));
+    pthread_mutex_init(&gate->mutex, NULL);
+    pthread_cond_init(&gate->changed, NULL);
+}
+
+static void start_gate_destroy(StartGate *gate) {
+    pthread_mutex_destroy(&gate->mutex);
+    pthread_cond_destroy(&gate->changed);
+}
+
+// Thread side: setup is done (setup_start is the thread's CPU clock when its
+// task began); wait until timing has started
+static void start_gate_arrive(StartGate *gate, struct timespec setup_start) {
+    struct timespec setup_end;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &setup_end);
+    pthread_mutex_lock(&gate->mutex);
+    gate->setup_cpu_seconds += timespec_diff(setup_end, setup_start);
+    gate->ready++;
+    pthread_cond_broadcast(&gate->changed);
+    while (!gate->open) {
+        pthread_cond_wait(&gate->changed, &gate->mutex);
+    }
+    pthread_mutex_unlock(&gate->mutex);
+}
+
+// Main side: wait for threads to finish setup, start the timers, release them
+static struct timespec start_gate_open(StartGate *gate, int threads, MethodResult *result) {
+    pthread_mutex_lock(&gate->mutex);
+    while (gate->ready < threads) {
+        pthread_cond_wait(&gate->changed, &gate->mutex);
+    }
+    cpu_timer_start(result);
+    struct timespec t0 = timer_start();
+    gate->open = 1;
+    pthread_cond_broadcast(&gate->changed);
+    pthread_mutex_unlock(&gate->mutex);
+    return t0;
+}
+
+// Queue lane of a reader or consumer: its pair under smt, its node under compact
+static int queue_lane(const BufferQueue *queue, int pair, int node) {
+    switch (pin_policy) {
+    case PIN_SMT:
+        return pair % queue->lanes;
+    case PIN_COMPACT:
+        return node % queue->lanes;
+    default:
+        return 0;
+    }
+}
+
+// Per-node share of the bytes hashed by a multi-threaded method
+static void print_node_throughput(const size_t *node_bytes, double seconds) {
+    if ((pin_policy == PIN_NONE && verbosity < 2) || verbosity < 0) {
+        return;
+    }
+    for (int node = 0; node < topology.num_nodes && node < TOPOLOGY_MAX_NODES; node++) {
+        if (node_bytes[node] == 0) {
+            continue;
+        }
+        printf("  Node %d: %zu bytes, %.3f GB/s\n", node, node_bytes[node],
+               seconds > 0 ? node_bytes[node] / seconds / 1e9 : 0.0);
+    }
+}
+
+
+// In-flight byte budget
+static void budget_init(ByteBudget *budget, size_t limit) {
+    budget->limit = limit > 0 ? limit : SIZE_MAX;
+    budget->used = 0;
+    budget->peak = 0;
+    pthread_mutex_init(&budget->mutex, NULL);
+    pthread_cond_init(&budget->released, NULL);
+}
+
+static void budget_destroy(ByteBudget *budget) {
+    pthread_mutex_destroy(&budget->mutex);
+    pthread_cond_destroy(&budget->released);
+}
+
+// Wait until bytes fit under the limit and reserve them (async_slice_size
+// keeps every request small enough to fit). Returns the amount reserved, to
+// be handed back to budget_release.
+static size_t budget_reserve(ByteBudget *budget, size_t bytes) {
+    lock_mutex(&budget->mutex);
+    while (budget->used + bytes > budget->limit) {
+        pthread_cond_wait(&budget->released, &budget->mutex);
+    }
+    budget->used += bytes;
+    if (budget->used > budget->peak) {
+        budget->peak = budget->used;
+    }
+    pthread_mutex_unlock(&budget->mutex);
+    return bytes;
+}
+
+static void budget_release(ByteBudget *budget, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    lock_mutex(&budget->mutex);
+    budget->used -= bytes;
+    pthread_cond_broadcast(&budget->released);
+    pthread_mutex_unlock(&budget->mutex);
+}
+
+// Bytes async readers read and queue at a time: --chunk-size slices or whole
+// blocks. Under --max-inflight-bytes, slices shrink until every reader's
+// staging buffer plus one queued slice fit the budget; 0 when even page-sized
+// slices do not.
+static size_t async_slice_size(const MethodParams *params, int readers) {
+    size_t slice = chunk_size > 0 && chunk_size < params->block_size ? chunk_size : params->block_size;
+    if (max_inflight_bytes > 0 && max_inflight_bytes / (readers + 1) < slice) {
+        slice = max_inflight_bytes / (readers + 1) / SLICE_ALIGNMENT * SLICE_ALIGNMENT;
+    }
+    return slice;
+}
 
 // Forward declarations for async processing
 void* process_buffers(void *arg);
 void* reader_thread(void *arg);
+void* work_stealing_worker(void *arg);
+void* ordered_reader_thread(void *arg);
+void* iops_worker(void *arg);
 
 // Buffer queue management
-void init_buffer_queue(BufferQueue *queue) {
-    queue->head = NULL;
-    queue->tail = NULL;
+void init_buffer_queue(BufferQueue *queue, const MethodParams *params) {
+    memset(queue->head, 0, sizeof(queue->head));
+    memset(queue->tail, 0, sizeof(queue->tail));
+    queue->lanes = 1;
+    queue->foreign_slices = 0;
     queue->count = 0;
     queue->reading_done = 0;
     queue->active_readers = 0;
@@ -203,53 +1047,77 @@ void init_buffer_queue(BufferQueue *queue) {
     queue->total_blocks = 0;
     queue->next_block = 0;
     queue->file_size = 0;
+    memset(queue->node_bytes, 0, sizeof(queue->node_bytes));
+    queue->slices_hashed = 0;
+    queue->cross_node_slices = 0;
+    queue->bytes_hashed = 0;
+    queue->block_size = params->block_size;
+    queue->reader_limit = params->readers;
+    queue->consumer_limit = params->consumers;
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);  // tuner deadlines use timer_start()
+    pthread_cond_init(&queue->tune_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    queue->first_hash_time = -1.0;
+    budget_init(&queue->budget, max_inflight_bytes);
 }
 
 void cleanup_buffer_queue(BufferQueue *queue) {
-    BufferNode *node = queue->head;
-    while (node) {
-        BufferNode *next = node->next;
-        free(node->data);
-        free(node);
-        node = next;
+    for (int lane = 0; lane < queue->lanes; lane++) {
+        BufferNode *node = queue->head[lane];
+        while (node) {
+            BufferNode *next = node->next;
+            buffer_pool_release(&queue->session->buffers, node->data);
+            budget_release(&queue->budget, node->reserved);
+            free(node);
+            node = next;
+        }
     }
+    budget_destroy(&queue->budget);
     pthread_mutex_destroy(&queue->mutex);
+    pthread_cond_destroy(&queue->tune_cond);
     sem_destroy(&queue->empty_slots);
     sem_destroy(&queue->full_slots);
 }
 
 // Producer: add buffer to queue
-int enqueue_buffer(BufferQueue *queue, const unsigned char *data, size_t size) {
+int enqueue_buffer(BufferQueue *queue, int lane, const unsigned char *data, size_t size,
+                   int src_node, size_t tail_bytes, size_t reserved) {
+    uint64_t wait_start = span_begin();
     sem_wait(&queue->empty_slots);
-    pthread_mutex_lock(&queue->mutex);
+    span_end(SPAN_ENQUEUE_WAIT, wait_start);
     
-    BufferNode *node = (BufferNode*)malloc(sizeof(BufferNode));
-    if (!node) {
-        pthread_mutex_unlock(&queue->mutex);
-        sem_post(&queue->empty_slots);
-        return 0;
-    }
+    // Take the session buffer before locking: acquire may wait for a release
+    unsigned char *buffer = buffer_pool_acquire(&queue->session->buffers);
+    lock_mutex(&queue->mutex);
     
-    node->data = (unsigned char*)malloc(size);
-    if (!node->data) {
+    BufferNode *node = (BufferNode*)malloc(sizeof(BufferNode));
+    if (!node || !buffer) {
         free(node);
         pthread_mutex_unlock(&queue->mutex);
+        buffer_pool_release(&queue->session->buffers, buffer);
         sem_post(&queue->empty_slots);
         return 0;
     }
     
+    node->data = buffer;
     memcpy(node->data, data, size);
     node->size = size;
+    node->node = src_node;
+    node->tail_bytes = tail_bytes;
+    node->reserved = reserved;
     node->next = NULL;
     
-    // Add to end of queue
-    if (queue->tail) {
-        queue->tail->next = node;
+    // Add to end of the reader's lane
+    if (queue->tail[lane]) {
+        queue->tail[lane]->next = node;
     } else {
-        queue->head = node;
+        queue->head[lane] = node;
     }
-    queue->tail = node;
+    queue->tail[lane] = node;
     queue->count++;
+    progress_set_depth(queue->count);
     
     pthread_mutex_unlock(&queue->mutex);
     sem_post(&queue->full_slots);
@@ -257,9 +1125,12 @@ int enqueue_buffer(BufferQueue *queue, const unsigned char *data, size_t size) {
 }
 
 // Consumer: get buffer from queue
-int dequeue_buffer(BufferQueue *queue, unsigned char **data, size_t *size) {
+int dequeue_buffer(BufferQueue *queue, int lane, unsigned char **data, size_t *size,
+                   int *src_node, size_t *tail_bytes, size_t *reserved) {
+    uint64_t wait_start = span_begin();
     sem_wait(&queue->full_slots);
-    pthread_mutex_lock(&queue->mutex);
+    span_end(SPAN_DEQUEUE_WAIT, wait_start);
+    lock_mutex(&queue->mutex);
     
     // Check if reading is complete and queue is empty
     if (queue->count == 0) {
@@ -271,34 +1142,65 @@ int dequeue_buffer(BufferQueue *queue, unsigned char **data, size_t *size) {
         return 0;
     }
     
-    // Remove first node
-    BufferNode *node = queue->head;
-    queue->head = node->next;
-    if (!queue->head) {
-        queue->tail = NULL;
+    // Remove the first node of the consumer's lane, or of the next lane
+    // holding one when its own is empty
+    int from = lane;
+    while (!queue->head[from]) {
+        from = (from + 1) % queue->lanes;
+    }
+    if (from != lane) {
+        queue->foreign_slices++;
+    }
+    BufferNode *node = queue->head[from];
+    queue->head[from] = node->next;
+    if (!queue->head[from]) {
+        queue->tail[from] = NULL;
     }
     queue->count--;
+    progress_set_depth(queue->count);
     
     pthread_mutex_unlock(&queue->mutex);
     sem_post(&queue->empty_slots);
     
     *data = node->data;
     *size = node->size;
+    *src_node = node->node;
+    *tail_bytes = node->tail_bytes;
+    *reserved = node->reserved;
     free(node);
     return 1;
 }
 
 // Data processing
-void process_buffer_data(const unsigned char *data, size_t size) {
+void process_buffer_data(BufferQueue *queue, const unsigned char *data, size_t size,
+                         int src_node, int node, size_t tail_bytes) {
+    uint64_t hash_start = span_begin();
     uint64_t block_hash = crc64_compute(data, size);
     
+    // A slice contributes its CRC advanced over the rest of its block; the XOR
+    // of all slice contributions equals the CRC of the whole block
+    if (tail_bytes > 0) {
+        block_hash = crc64_combine(block_hash, 0, tail_bytes);
+    }
+    span_end(SPAN_HASH, hash_start);
+    progress_add(size);
+    
     // XOR allows order-independent hashing for parallel processing
-    pthread_mutex_lock(&hash_mutex);
+    lock_mutex(&hash_mutex);
     global_hash_xor ^= block_hash;
+    queue->node_bytes[node] += size;
+    queue->bytes_hashed += size;
+    queue->slices_hashed++;
+    if (src_node != node) {
+        queue->cross_node_slices++;
+    }
+    if (queue->first_hash_time < 0) {
+        queue->first_hash_time = timer_elapsed(queue->start_time);
+    }
     pthread_mutex_unlock(&hash_mutex);
     
     if (verbosity >= 2) {
-        printf("Processed buffer: %zu bytes, block_hash: %016llx\n", 
+        printf("Processed buffer: %zu bytes, slice_hash: %016llx\n", 
                size, (unsigned long long)block_hash);
     }
 }
@@ -307,100 +1209,266 @@ void process_buffer_data(const unsigned char *data, size_t size) {
 // File Reading Functions
 // ============================================================================
 
-// Multi-threaded async reading with producer-consumer pattern
-void async_sequential_read(String filename) {
-    struct timespec t0;
-    size_t file_size;
-    
-    if (verbosity >= 2) {
-        printf("Async sequential read with %d readers and %d consumers: %s\n", 
-               NUM_READERS, NUM_CONSUMERS, filename);
+// Apply (or undo, with undo=1) one hill-climbing move; returns 0 if out of range
+static int apply_tune_action(BufferQueue *queue, TuneAction action, int undo) {
+    int step = undo ? -1 : 1;
+    int *limit;
+    int max;
+    switch (action) {
+    case TUNE_ADD_READER:    limit = &queue->reader_limit;   max = MAX_READERS;   break;
+    case TUNE_PARK_READER:   limit = &queue->reader_limit;   max = MAX_READERS;   step = -step; break;
+    case TUNE_ADD_CONSUMER:  limit = &queue->consumer_limit; max = MAX_CONSUMERS; break;
+    case TUNE_PARK_CONSUMER: limit = &queue->consumer_limit; max = MAX_CONSUMERS; step = -step; break;
+    default:
+        return 0;
     }
-    
-    if (!get_file_size(filename, &file_size)) {
-        return;
+    if (*limit + step < 1 || *limit + step > max) {
+        return 0;
     }
+    *limit += step;
+    pthread_cond_broadcast(&queue->tune_cond);
+    return 1;
+}
+
+// Auto-tuner loop run by the main thread while readers are active: samples
+// throughput and queue occupancy, then hill-climbs the reader/consumer split
+static void run_auto_tuner(BufferQueue *queue) {
+    TuneAction last_action = TUNE_NONE;
+    double last_throughput = 0.0;
+    size_t last_bytes = 0;
+    int adjustments = 0;
+    int cooldown = 0;
     
-    // Setup
-    BufferQueue queue;
-    init_buffer_queue(&queue);
-    setup_hashing();
-    global_hash_xor = 0;
-    queue.file_size = file_size;
-    queue.total_blocks = (file_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
-    queue.next_block = 0;
-    
-    // Start consumer threads first
-    pthread_t consumer_threads[NUM_CONSUMERS];
-    for (int i = 0; i < NUM_CONSUMERS; i++) {
-        int thread_rc = pthread_create(&consumer_threads[i], NULL, process_buffers, &queue);
-        if (thread_rc != 0) {
+    while (1) {
+        struct timespec tick = timer_start();
+        struct timespec deadline = tick;
+        deadline.tv_nsec += TUNE_INTERVAL_MS * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        
+        // Sleep one interval, waking early when the last block is claimed
+        lock_mutex(&queue->mutex);
+        while (queue->next_block < queue->total_blocks) {
+            if (pthread_cond_timedwait(&queue->tune_cond, &queue->mutex, &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+        if (queue->next_block >= queue->total_blocks) {
+            pthread_mutex_unlock(&queue->mutex);
+            break;
+        }
+        double dt = timer_elapsed(tick);
+        
+        lock_mutex(&hash_mutex);
+        size_t bytes = queue->bytes_hashed;
+        pthread_mutex_unlock(&hash_mutex);
+
+        double occupancy = (double)queue->count / MAX_QUEUE_SIZE;
+        double throughput = (bytes - last_bytes) / dt;
+        last_bytes = bytes;
+        
+        TuneAction action = TUNE_NONE;
+        if (last_action != TUNE_NONE && throughput < last_throughput * 0.97) {
+            // Last move hurt: step back and let the next sample re-measure
+            apply_tune_action(queue, last_action, 1);
             if (verbosity >= 2) {
-                fprintf(stderr, "Error: Failed to create consumer thread %d (%d)\n", i, thread_rc);
+                printf("Auto-tune: reverted (%.3f GB/s < %.3f GB/s)\n",
+                       throughput / 1e9, last_throughput / 1e9);
             }
-            cleanup_buffer_queue(&queue);
-            return;
+            adjustments++;
+            last_action = TUNE_NONE;
+            last_throughput = 0.0;
+            cooldown = TUNE_COOLDOWN;
+            pthread_mutex_unlock(&queue->mutex);
+            continue;
         }
+        
+        if (cooldown > 0) {
+            cooldown--;
+        } else if (occupancy >= 0.75) {
+            // Queue backing up: consumers are the bottleneck
+            action = TUNE_ADD_CONSUMER;
+            if (!apply_tune_action(queue, action, 0)) {
+                action = TUNE_PARK_READER;
+                if (!apply_tune_action(queue, action, 0)) {
+                    action = TUNE_NONE;
+                }
+            }
+        } else if (occupancy <= 0.25) {
+            // Consumers starving: readers are the bottleneck
+            action = TUNE_ADD_READER;
+            if (!apply_tune_action(queue, action, 0)) {
+                action = TUNE_PARK_CONSUMER;
+                if (!apply_tune_action(queue, action, 0)) {
+                    action = TUNE_NONE;
+                }
+            }
+        }
+        
         if (verbosity >= 2) {
-            printf("Created consumer thread %d\n", i);
+            printf("Auto-tune: %.3f GB/s, queue %d/%d -> %d readers, %d consumers\n",
+                   throughput / 1e9, queue->count, MAX_QUEUE_SIZE,
+                   queue->reader_limit, queue->consumer_limit);
         }
-    }
+        pthread_mutex_unlock(&queue->mutex);
+        
+        if (action != TUNE_NONE) {
+            adjustments++;
+        }
+        last_action = action;
+        last_throughput = throughput;
+    }
     
-    // Start timing after setup
-    t0 = timer_start();
+    if (verbosity >= 1) {
+        printf("Auto-tune: settled on %d readers, %d consumers (%d adjustments)\n",
+               queue->reader_limit, queue->consumer_limit, adjustments);
+    }
+}
+
+// Multi-threaded async reading with producer-consumer pattern
+void async_sequential_read(BenchSession *session, String filename, const MethodParams *params,
+                           MethodResult *result) {
+    struct timespec t0;
+    size_t file_size;
+    
+    // With auto-tune, spawn the maximum and park those beyond the current limits
+    int num_readers = auto_tune ? MAX_READERS : params->readers;
+    int num_consumers = auto_tune ? MAX_CONSUMERS : params->consumers;
+    
+    if (verbosity >= 2) {
+        printf("Async sequential read with %d readers and %d consumers (pin: %s%s, chunk: %zu): %s\n", 
+               params->readers, params->consumers, topology_policy_name(pin_policy),
+               auto_tune ? ", auto-tune" : "", chunk_size, filename);
+    }
+    
+    if (!get_file_size(filename, &file_size)) {
+        return;
+    }
+    
+    // Setup
+    BufferQueue queue;
+    init_buffer_queue(&queue, params);
+    queue.session = session;
+    setup_hashing();
+    global_hash_xor = 0;
+    queue.file_size = file_size;
+    queue.total_blocks = (file_size + params->block_size - 1) / params->block_size;
+    queue.next_block = 0;
+    queue.slice_size = async_slice_size(params, num_readers);
+    if (pin_policy == PIN_SMT) {
+        queue.lanes = num_readers < num_consumers ? num_readers : num_consumers;
+    } else if (pin_policy == PIN_COMPACT) {
+        queue.lanes = topology.num_nodes;
+    }
+    if (queue.lanes > MAX_QUEUE_LANES) {
+        queue.lanes = MAX_QUEUE_LANES;
+    }
+    if (queue.slice_size == 0) {
+        if (verbosity >= 0) {
+            printf("Async sequential read: --max-inflight-bytes %zu cannot hold a buffer for each "
+                   "of %d readers plus one slice, skipped\n", max_inflight_bytes, num_readers);
+        }
+        cleanup_buffer_queue(&queue);
+        return;
+    }
+    
+    // Make sure the session has a worker for every task before timing
+    thread_pool_reserve(&session->pool, num_readers + num_consumers);
+    
+    // Start consumer tasks first
+    TaskGroup consumers;
+    task_group_init(&consumers);
+    ConsumerArgs consumer_args[MAX_CONSUMERS];
+    for (int i = 0; i < num_consumers; i++) {
+        consumer_args[i].queue = &queue;
+        consumer_args[i].consumer_id = i;
+        if (!thread_pool_submit(&session->pool, &consumers, process_buffers, &consumer_args[i])) {
+            if (verbosity >= 2) {
+                fprintf(stderr, "Error: Failed to start consumer %d\n", i);
+            }
+            num_consumers = i;
+            break;
+        }
+        if (verbosity >= 2) {
+            printf("Started consumer %d\n", i);
+        }
+    }
     
-    // Create reader threads that will pull BLOCK_SIZE-aligned blocks round-robin
-    pthread_t reader_threads[NUM_READERS];
-    queue.active_readers = NUM_READERS;
-    for (int i = 0; i < NUM_READERS; i++) {
+    // Start reader tasks that will pull block-aligned blocks round-robin; they
+    // set up (pinned ones fault in their buffers) and wait for timing to start
+    StartGate gate;
+    start_gate_init(&gate);
+    TaskGroup readers;
+    task_group_init(&readers);
+    queue.active_readers = num_readers;
+    int started = 0;
+    for (int i = 0; i < num_readers; i++) {
         ReaderArgs *args = (ReaderArgs*)malloc(sizeof(ReaderArgs));
         args->filename = filename;
         args->queue = &queue;
+        args->gate = &gate;
         args->reader_id = i;
         args->start_offset = 0; // unused in new scheme
         args->end_offset = 0;   // unused in new scheme
         
-        int thread_rc = pthread_create(&reader_threads[i], NULL, reader_thread, args);
-        if (thread_rc != 0) {
+        if (!thread_pool_submit(&session->pool, &readers, reader_thread, args)) {
             if (verbosity >= 2) {
-                fprintf(stderr, "Error: Failed to create reader thread %d (%d)\n", i, thread_rc);
+                fprintf(stderr, "Error: Failed to start reader %d\n", i);
             }
-            pthread_mutex_lock(&queue.mutex);
+            lock_mutex(&queue.mutex);
             queue.active_readers--;
+            if (queue.active_readers == 0) {
+                queue.reading_done = 1;
+            }
             pthread_mutex_unlock(&queue.mutex);
             free(args);
         } else {
+            started++;
             if (verbosity >= 2) {
-                printf("Created reader thread %d (offset %zu to %zu)\n", 
-                       i, args->start_offset, args->end_offset);
+                printf("Started reader %d\n", i);
             }
         }
     }
     
-    // Wait for all readers to finish
-    for (int i = 0; i < NUM_READERS; i++) {
-        pthread_join(reader_threads[i], NULL);
+    // Start timing after setup
+    t0 = start_gate_open(&gate, started, result);
+    queue.start_time = t0;
+    
+    if (auto_tune) {
+        run_auto_tuner(&queue);
     }
     
+    // Wait for all readers to finish
+    task_group_wait(&readers);
+    double reader_cpu = readers.cpu_seconds - gate.setup_cpu_seconds;
+    task_group_destroy(&readers);
+    start_gate_destroy(&gate);
+    
     if (verbosity >= 2) {
         printf("All reader threads completed\n");
     }
     
-    // Wake up consumers to check for completion
-    for (int i = 0; i < NUM_CONSUMERS; i++) {
+    // Wake up consumers (parked ones included) to check for completion
+    lock_mutex(&queue.mutex);
+    pthread_cond_broadcast(&queue.tune_cond);
+    pthread_mutex_unlock(&queue.mutex);
+    for (int i = 0; i < num_consumers; i++) {
         sem_post(&queue.full_slots);
     }
     
     // Wait for all consumers to finish
-    for (int i = 0; i < NUM_CONSUMERS; i++) {
-        pthread_join(consumer_threads[i], NULL);
-    }
+    task_group_wait(&consumers);
+    double consumer_cpu = consumers.cpu_seconds;
+    task_group_destroy(&consumers);
     
     if (verbosity >= 2) {
         printf("All consumer threads completed\n");
     }
     
     // Output results
+    double elapsed = timer_elapsed(t0);
+    cpu_timer_stop(result);
+    result->worker_cpu_seconds = reader_cpu + consumer_cpu;
     uint64_t final_hash = global_hash_xor;
     if (verbosity >= 1) {
         printf("Hash (XOR): %016llx\n", (unsigned long long)final_hash);
@@ -409,33 +1477,69 @@ void async_sequential_read(String filename) {
         printf("Total file size: %zu bytes\n", file_size);
     }
     
-    timer_end_print("Async sequential read", t0);
+    result->seconds = elapsed;
+    result->hash = final_hash;
+    result->total_bytes = queue.bytes_hashed;
+    if (auto_tune) {
+        result->readers = queue.reader_limit;
+        result->consumers = queue.consumer_limit;
+        result->threads = queue.reader_limit + queue.consumer_limit;
+    }
+    
+    timer_end_print("Async sequential read", elapsed);
+    result_check_complete(result, file_size);
+    print_cpu_usage(result);
+    print_os_usage(result);
+    print_perf_counters(result);
+    if (verbosity >= 2) {
+        printf("  Reader CPU: %f seconds, consumer CPU: %f seconds\n", reader_cpu, consumer_cpu);
+    }
+    if ((chunk_size > 0 && verbosity >= 0) || verbosity >= 2) {
+        printf("  Time to first hash: %f seconds\n", queue.first_hash_time);
+    }
+    print_node_throughput(queue.node_bytes, elapsed);
+    if ((max_inflight_bytes > 0 && verbosity >= 0) || verbosity >= 2) {
+        // Whole buffers, staging included: what the pipeline actually held
+        printf("  Peak buffered: %zu bytes in %zu-byte slices", queue.budget.peak, queue.slice_size);
+        if (max_inflight_bytes > 0) {
+            printf(" (budget %zu)", max_inflight_bytes);
+        }
+        printf("\n");
+    }
+    if ((pin_policy != PIN_NONE && verbosity >= 0) || verbosity >= 2) {
+        printf("  Cross-node slices: %zu of %zu\n", queue.cross_node_slices, queue.slices_hashed);
+    }
+    if ((queue.lanes > 1 && verbosity >= 0) || verbosity >= 2) {
+        printf("  Slices hashed off their lane: %zu (%d lanes)\n", queue.foreign_slices, queue.lanes);
+    }
     cleanup_buffer_queue(&queue);
 }
 
 // Reader thread: reads assigned file portion and enqueues data
 void* reader_thread(void *arg) {
     ReaderArgs *args = (ReaderArgs*)arg;
+    struct timespec setup_start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &setup_start);
+    int node = place_thread(2 * args->reader_id);
+    int lane = queue_lane(args->queue, args->reader_id, node);
     
+    // A pinned reader faults in its node-local staging buffer before timing
+    // starts; unpinned ones take a pre-faulted pool buffer with their first
+    // block, so readers left without work hold none
     FILE *file = fopen(args->filename, "rb");
+    unsigned char *read_buffer = NULL;
+    size_t slice = args->queue->slice_size;
+    size_t staged = 0;
+    if (file && pin_policy != PIN_NONE && (size_t)args->reader_id < args->queue->total_blocks) {
+        staged = budget_reserve(&args->queue->budget, slice);
+        read_buffer = acquire_thread_buffer(args->queue->session, slice);
+    }
+    start_gate_arrive(args->gate, setup_start);
     if (!file) {
         if (verbosity >= 2) {
             printf("Reader %d: Error opening file %s\n", args->reader_id, args->filename);
         }
-        pthread_mutex_lock(&args->queue->mutex);
-        args->queue->active_readers--;
-        pthread_mutex_unlock(&args->queue->mutex);
-        free(args);
-        return NULL;
-    }
-    
-    unsigned char *read_buffer = malloc(BLOCK_SIZE);
-    if (!read_buffer) {
-        if (verbosity >= 2) {
-            printf("Reader %d: Error allocating buffer\n", args->reader_id);
-        }
-        fclose(file);
-        pthread_mutex_lock(&args->queue->mutex);
+        lock_mutex(&args->queue->mutex);
         args->queue->active_readers--;
         pthread_mutex_unlock(&args->queue->mutex);
         free(args);
@@ -445,19 +1549,43 @@ void* reader_thread(void *arg) {
     size_t bytes_read;
     size_t total_bytes = 0;
 
-    // Dynamically claim next block index and read BLOCK_SIZE-aligned chunks
+    // Dynamically claim next block index and read block-aligned chunks
     while (1) {
         size_t block_index;
-        pthread_mutex_lock(&args->queue->mutex);
+        uint64_t claim_start = span_begin();
+        lock_mutex(&args->queue->mutex);
+        // Parked by the auto-tuner until the limit is raised or work runs out
+        while (args->reader_id >= args->queue->reader_limit &&
+               args->queue->next_block < args->queue->total_blocks) {
+            pthread_cond_wait(&args->queue->tune_cond, &args->queue->mutex);
+        }
         if (args->queue->next_block >= args->queue->total_blocks) {
             pthread_mutex_unlock(&args->queue->mutex);
             break;
         }
         block_index = args->queue->next_block++;
+        if (args->queue->next_block == args->queue->total_blocks) {
+            pthread_cond_broadcast(&args->queue->tune_cond);  // release parked readers
+        }
         pthread_mutex_unlock(&args->queue->mutex);
+        span_end(SPAN_CLAIM, claim_start);
+
+        // The staging buffer is charged to the budget until the reader exits
+        if (!read_buffer) {
+            if (!staged) {
+                staged = budget_reserve(&args->queue->budget, slice);
+            }
+            read_buffer = acquire_thread_buffer(args->queue->session, slice);
+            if (!read_buffer) {
+                if (verbosity >= 2) {
+                    printf("Reader %d: Error allocating buffer\n", args->reader_id);
+                }
+                break;
+            }
+        }
 
-        size_t offset = block_index * BLOCK_SIZE;
-        size_t bytes_to_read = BLOCK_SIZE;
+        size_t offset = block_index * args->queue->block_size;
+        size_t bytes_to_read = args->queue->block_size;
         if (offset + bytes_to_read > args->queue->file_size) {
             bytes_to_read = args->queue->file_size - offset;
         }
@@ -465,17 +1593,33 @@ void* reader_thread(void *arg) {
         if (fseek(file, offset, SEEK_SET) != 0) {
             break;
         }
-        bytes_read = fread(read_buffer, 1, bytes_to_read, file);
-        if (bytes_read == 0) {
+
+        // Publish the block slice by slice so consumers start before it is complete
+        size_t block_read = 0;
+        while (block_read < bytes_to_read) {
+            size_t slice_len = bytes_to_read - block_read < slice ? bytes_to_read - block_read : slice;
+            // Reserve the queued copy's buffer before touching the device;
+            // held until the slice is hashed
+            size_t reserved = budget_reserve(&args->queue->budget, slice);
+            bytes_read = read_block(read_buffer, slice_len, file);
+            if (bytes_read == 0) {
+                budget_release(&args->queue->budget, reserved);
+                break;
+            }
+            block_read += bytes_read;
+            if (!enqueue_buffer(args->queue, lane, read_buffer, bytes_read, node,
+                                bytes_to_read - block_read, reserved)) {
+                budget_release(&args->queue->budget, reserved);
+            }
+        }
+        if (block_read == 0) {
             break;
         }
-
-        enqueue_buffer(args->queue, read_buffer, bytes_read);
-        total_bytes += bytes_read;
+        total_bytes += block_read;
 
         if (verbosity >= 2) {
             printf("Reader %d: Enqueued block %zu (offset %zu, size %zu)\n",
-                   args->reader_id, block_index, offset, bytes_read);
+                   args->reader_id, block_index, offset, block_read);
         }
     }
     
@@ -483,14 +1627,16 @@ void* reader_thread(void *arg) {
         printf("Reader %d: Completed, read %zu bytes\n", args->reader_id, total_bytes);
     }
     
-    free(read_buffer);
+    release_thread_buffer(args->queue->session, read_buffer);
+    budget_release(&args->queue->budget, staged);
     fclose(file);
     
     // Mark reader as done
-    pthread_mutex_lock(&args->queue->mutex);
+    lock_mutex(&args->queue->mutex);
     args->queue->active_readers--;
     if (args->queue->active_readers == 0) {
         args->queue->reading_done = 1;
+        pthread_cond_broadcast(&args->queue->tune_cond);  // release parked consumers
     }
     pthread_mutex_unlock(&args->queue->mutex);
     
@@ -500,13 +1646,24 @@ void* reader_thread(void *arg) {
 
 // Consumer thread: processes buffers from queue
 void* process_buffers(void *arg) {
-    BufferQueue *queue = (BufferQueue*)arg;
+    ConsumerArgs *args = (ConsumerArgs*)arg;
+    BufferQueue *queue = args->queue;
     unsigned char *data = NULL;
     size_t size = 0;
+    int src_node = 0;
+    size_t tail_bytes = 0;
+    size_t reserved = 0;
+    int node = place_thread(2 * args->consumer_id + 1);
+    int lane = queue_lane(queue, args->consumer_id, node);
     
     while (1) {
         // Check if all reading is complete and queue is empty
-        pthread_mutex_lock(&queue->mutex);
+        lock_mutex(&queue->mutex);
+        // Parked by the auto-tuner; all consumers resume once reading is done
+        while (args->consumer_id >= queue->consumer_limit &&
+               !(queue->reading_done && queue->active_readers == 0)) {
+            pthread_cond_wait(&queue->tune_cond, &queue->mutex);
+        }
         int done = queue->reading_done && queue->active_readers == 0 && queue->count == 0;
         pthread_mutex_unlock(&queue->mutex);
         
@@ -515,281 +1672,2993 @@ void* process_buffers(void *arg) {
         }
         
         // Process available buffers
-        if (dequeue_buffer(queue, &data, &size)) {
-            process_buffer_data(data, size);
-            free(data);
+        if (dequeue_buffer(queue, lane, &data, &size, &src_node, &tail_bytes, &reserved)) {
+            process_buffer_data(queue, data, size, src_node, node, tail_bytes);
+            buffer_pool_release(&queue->session->buffers, data);
+            budget_release(&queue->budget, reserved);
         }
     }
     
     return NULL;
 }
 
-// Standard sequential file reading
-void sequential_read(String filename) {
+// Multi-threaded fused read+hash with work stealing: every worker reads a
+// block and hashes it in place, so data never leaves the core it landed on
+void work_stealing_read(BenchSession *session, String filename, const MethodParams *params,
+                        MethodResult *result) {
     struct timespec t0;
     size_t file_size;
     
     if (verbosity >= 2) {
-        printf("Sequential read: %s\n", filename);
+        printf("Work-stealing read with %d workers (pin: %s): %s\n",
+               params->workers, topology_policy_name(pin_policy), filename);
     }
     
     if (!get_file_size(filename, &file_size)) {
         return;
     }
     
-    FILE *file = fopen(filename, "rb");
-    if (!file) {
-        if (verbosity >= 2) {
-            printf("Error: Cannot open file %s\n", filename);
-        }
-        return;
-    }
-    
     setup_hashing();
-    uint64_t hash_xor = 0;
     
-    unsigned char *buffer = malloc(BLOCK_SIZE);
-    if (!buffer) {
-        if (verbosity >= 2) {
-            printf("Error: Cannot allocate memory for buffer\n");
+    // Split blocks into contiguous per-worker ranges
+    int num_workers = params->workers;
+    size_t total_blocks = (file_size + params->block_size - 1) / params->block_size;
+    WorkRange ranges[MAX_WORKERS];
+    WorkerArgs args[MAX_WORKERS];
+    StartGate gate;
+    start_gate_init(&gate);
+    for (int i = 0; i < num_workers; i++) {
+        pthread_mutex_init(&ranges[i].mutex, NULL);
+        ranges[i].next_block = total_blocks * i / num_workers;
+        ranges[i].end_block = total_blocks * (i + 1) / num_workers;
+        
+        args[i].filename = filename;
+        args[i].session = session;
+        args[i].gate = &gate;
+        args[i].ranges = ranges;
+        args[i].num_workers = num_workers;
+        args[i].worker_id = i;
+        args[i].file_size = file_size;
+        args[i].block_size = params->block_size;
+        args[i].hash_xor = 0;
+        args[i].total_bytes = 0;
+        args[i].steals = 0;
+        args[i].node = 0;
+    }
+    
+    // Workers whose task fails to start simply have their range stolen; the
+    // others set up (pinned ones fault in their buffers) before timing starts
+    thread_pool_reserve(&session->pool, num_workers);
+    TaskGroup workers;
+    task_group_init(&workers);
+    int started = 0;
+    for (int i = 0; i < num_workers; i++) {
+        if (thread_pool_submit(&session->pool, &workers, work_stealing_worker, &args[i])) {
+            started++;
+        } else if (verbosity >= 2) {
+            fprintf(stderr, "Error: Failed to start worker %d\n", i);
         }
-        fclose(file);
-        return;
     }
+    t0 = start_gate_open(&gate, started, result);
+    task_group_wait(&workers);
+    result->worker_cpu_seconds = workers.cpu_seconds - gate.setup_cpu_seconds;
+    task_group_destroy(&workers);
+    start_gate_destroy(&gate);
     
-    size_t bytes_read;
+    // Merge worker-local hashes (XOR keeps the result order-independent)
+    uint64_t hash_xor = 0;
     size_t total_bytes = 0;
-    t0 = timer_start();
+    size_t total_steals = 0;
+    size_t node_bytes[TOPOLOGY_MAX_NODES] = {0};
+    for (int i = 0; i < num_workers; i++) {
+        hash_xor ^= args[i].hash_xor;
+        total_bytes += args[i].total_bytes;
+        total_steals += args[i].steals;
+        node_bytes[args[i].node] += args[i].total_bytes;
+    }
+    double elapsed = timer_elapsed(t0);
     
-    // Read and hash file in blocks (order-independent XOR)
-    while ((bytes_read = fread(buffer, 1, BLOCK_SIZE, file)) > 0) {
-        process_block_xor(buffer, bytes_read, &hash_xor);
-        total_bytes += bytes_read;
-        
-        if (verbosity >= 2) {
-            printf("Read %zu bytes (total: %zu)\n", bytes_read, total_bytes);
-        }
+    if (verbosity >= 2) {
+        printf("All worker threads completed (%zu steals)\n", total_steals);
     }
     
-    print_results("Sequential read", hash_xor, total_bytes, t0);
-    free(buffer);
-    fclose(file);
+    print_results("Work-stealing read", hash_xor, total_bytes, file_size, t0, result);
+    print_node_throughput(node_bytes, elapsed);
+    
+    for (int i = 0; i < num_workers; i++) {
+        pthread_mutex_destroy(&ranges[i].mutex);
+    }
 }
 
-// Random access pattern: alternating from ends toward center
-void random_read(String filename) {
-    struct timespec t0;
-    size_t file_size;
+// Steal the back half of the fullest other range into the worker's own range.
+// Returns 0 when every other range is empty.
+static int steal_blocks(WorkerArgs *args) {
+    WorkRange *ranges = args->ranges;
+    int victim = -1;
+    size_t victim_left = 0;
     
-    if (verbosity >= 2) {
-        printf("Random read: %s\n", filename);
+    // Pick the victim with the most remaining blocks
+    for (int i = 1; i < args->num_workers; i++) {
+        int candidate = (args->worker_id + i) % args->num_workers;
+        lock_mutex(&ranges[candidate].mutex);
+        size_t left = ranges[candidate].end_block - ranges[candidate].next_block;
+        pthread_mutex_unlock(&ranges[candidate].mutex);
+        if (left > victim_left) {
+            victim = candidate;
+            victim_left = left;
+        }
     }
-    
-    if (!get_file_size(filename, &file_size)) {
-        return;
+    if (victim < 0) {
+        return 0;
     }
     
-    FILE *file = fopen(filename, "rb");
-    if (!file) {
-        if (verbosity >= 2) {
-            printf("Error: Cannot open file %s\n", filename);
-        }
-        return;
+    // Re-check under the lock: the owner or another thief may have moved on
+    lock_mutex(&ranges[victim].mutex);
+    size_t left = ranges[victim].end_block - ranges[victim].next_block;
+    size_t take = (left + 1) / 2;
+    size_t stolen_end = ranges[victim].end_block;
+    ranges[victim].end_block -= take;
+    pthread_mutex_unlock(&ranges[victim].mutex);
+    
+    if (take == 0) {
+        return 1;  // lost the race, scan again
     }
     
-    size_t num_blocks = (file_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    WorkRange *own = &ranges[args->worker_id];
+    lock_mutex(&own->mutex);
+    own->next_block = stolen_end - take;
+    own->end_block = stolen_end;
+    pthread_mutex_unlock(&own->mutex);
+    
+    args->steals++;
     if (verbosity >= 2) {
-        printf("Number of blocks: %zu\n", num_blocks);
+        printf("Worker %d: Stole blocks %zu-%zu from worker %d\n",
+               args->worker_id, stolen_end - take, stolen_end - 1, victim);
     }
+    return 1;
+}
+
+// Worker thread: claims blocks from its own range, reads and hashes them in place
+void* work_stealing_worker(void *arg) {
+    WorkerArgs *args = (WorkerArgs*)arg;
+    WorkRange *own = &args->ranges[args->worker_id];
+    struct timespec setup_start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &setup_start);
+    args->node = place_thread(args->worker_id);
     
-    setup_hashing();
-    uint64_t hash_xor = 0;
-    
-    unsigned char *buffer = malloc(BLOCK_SIZE);
-    if (!buffer) {
+    // A pinned worker with a range faults in its node-local buffer before
+    // timing starts; unpinned ones take a pre-faulted pool buffer with their
+    // first block, so workers left without work hold none
+    FILE *file = fopen(args->filename, "rb");
+    unsigned char *buffer = NULL;
+    if (file && pin_policy != PIN_NONE && own->next_block < own->end_block) {
+        buffer = acquire_thread_buffer(args->session, args->block_size);
+    }
+    start_gate_arrive(args->gate, setup_start);
+    if (!file) {
         if (verbosity >= 2) {
-            printf("Error: Cannot allocate memory for buffer\n");
+            printf("Worker %d: Error opening file %s\n", args->worker_id, args->filename);
         }
-        fclose(file);
-        return;
+        return NULL;
     }
     
-    size_t total_bytes = 0;
-    t0 = timer_start();
-    
-    // Read blocks in alternating pattern: first, last, second, second-to-last, etc.
-    for (size_t i = 0; i < (num_blocks + 1) / 2; i++) {
-        size_t first_block = i;
-        size_t last_block = num_blocks - 1 - i;
+    while (1) {
+        size_t block_index;
+        uint64_t claim_start = span_begin();
+        lock_mutex(&own->mutex);
+        int have_block = own->next_block < own->end_block;
+        block_index = own->next_block;
+        if (have_block) {
+            own->next_block++;
+        }
+        pthread_mutex_unlock(&own->mutex);
         
-        // Read first block
-        if (first_block < num_blocks) {
-            size_t offset = first_block * BLOCK_SIZE;
-            size_t block_size = (offset + BLOCK_SIZE > file_size) ? 
-                               (file_size - offset) : BLOCK_SIZE;
-            
-            fseek(file, offset, SEEK_SET);
-            size_t bytes_read = fread(buffer, 1, block_size, file);
-            
-            if (bytes_read > 0) {
-                process_block_xor(buffer, bytes_read, &hash_xor);
-                total_bytes += bytes_read;
-                if (verbosity >= 2) {
-                    printf("Read block %zu (offset %zu, size %zu)\n", 
-                           first_block, offset, bytes_read);
-                }
+        if (!have_block) {
+            int stole = steal_blocks(args);
+            span_end(SPAN_STEAL, claim_start);
+            if (!stole) {
+                break;
             }
+            continue;
         }
+        span_end(SPAN_CLAIM, claim_start);
         
-        // Read last block (if different from first)
-        if (last_block != first_block && last_block < num_blocks) {
-            size_t offset = last_block * BLOCK_SIZE;
-            size_t block_size = (offset + BLOCK_SIZE > file_size) ? 
-                               (file_size - offset) : BLOCK_SIZE;
-            
-            fseek(file, offset, SEEK_SET);
-            size_t bytes_read = fread(buffer, 1, block_size, file);
-            
-            if (bytes_read > 0) {
-                process_block_xor(buffer, bytes_read, &hash_xor);
-                total_bytes += bytes_read;
+        if (!buffer) {
+            buffer = acquire_thread_buffer(args->session, args->block_size);
+            if (!buffer) {
                 if (verbosity >= 2) {
-                    printf("Read block %zu (offset %zu, size %zu)\n", 
-                           last_block, offset, bytes_read);
+                    printf("Worker %d: Error allocating buffer\n", args->worker_id);
                 }
+                break;
             }
         }
+        
+        size_t offset = block_index * args->block_size;
+        size_t bytes_to_read = args->block_size;
+        if (offset + bytes_to_read > args->file_size) {
+            bytes_to_read = args->file_size - offset;
+        }
+        
+        if (fseek(file, offset, SEEK_SET) != 0) {
+            break;
+        }
+        size_t bytes_read = read_block(buffer, bytes_to_read, file);
+        if (bytes_read == 0) {
+            break;
+        }
+        
+        // Hash while the block is still hot in this core's cache
+        process_block_xor(buffer, bytes_read, &args->hash_xor);
+        args->total_bytes += bytes_read;
+        
+        if (verbosity >= 2) {
+            printf("Worker %d: Processed block %zu (offset %zu, size %zu)\n",
+                   args->worker_id, block_index, offset, bytes_read);
+        }
     }
     
-    print_results("Random read", hash_xor, total_bytes, t0);
-    free(buffer);
+    if (verbosity >= 2) {
+        printf("Worker %d: Completed, read %zu bytes\n", args->worker_id, args->total_bytes);
+    }
+    
+    release_thread_buffer(args->session, buffer);
     fclose(file);
+    return NULL;
 }
 
-// ============================================================================
-// Memory-Mapped File Functions
-// ============================================================================
-
-// Sequential processing using memory mapping
-void sequential_mmap(String filename) {
+// Multi-threaded reads feeding a single in-order consumer through a reorder
+// buffer, so order-dependent work (here a streaming CRC) runs behind parallel I/O
+void ordered_async_read(BenchSession *session, String filename, const MethodParams *params,
+                        MethodResult *result) {
     struct timespec t0;
     size_t file_size;
     
     if (verbosity >= 2) {
-        printf("Sequential mmap: %s\n", filename);
+        printf("Ordered async read with %d readers, window %d: %s\n",
+               params->readers, params->window, filename);
     }
     
-    void *mapped_file = map_file(filename, &file_size);
-    if (!mapped_file) {
+    if (!get_file_size(filename, &file_size)) {
         return;
     }
     
     setup_hashing();
-    uint64_t hash_xor = 0;
-    t0 = timer_start();
     
-    // Process file in blocks from mapped memory
-    unsigned char *file_ptr = (unsigned char*)mapped_file;
-    size_t offset = 0;
-    size_t total_bytes = 0;
-    
-    while (offset < file_size) {
-        size_t block_size = (offset + BLOCK_SIZE > file_size) ? 
-                           (file_size - offset) : BLOCK_SIZE;
-        
-        process_block_xor(file_ptr + offset, block_size, &hash_xor);
-        total_bytes += block_size;
-        offset += block_size;
-        
-        if (verbosity >= 2) {
-            printf("Processed %zu bytes (total: %zu)\n", block_size, total_bytes);
+    ReorderBuffer rob;
+    memset(&rob, 0, sizeof(rob));
+    rob.file_size = file_size;
+    rob.block_size = params->block_size;
+    rob.window = params->window;
+    rob.total_blocks = (file_size + params->block_size - 1) / params->block_size;
+    pthread_mutex_init(&rob.mutex, NULL);
+    pthread_cond_init(&rob.window_advanced, NULL);
+    pthread_cond_init(&rob.block_landed, NULL);
+    // Slots past the file's last block are never used
+    for (int i = 0; i < rob.window && (size_t)i < rob.total_blocks; i++) {
+        rob.slot_data[i] = buffer_pool_acquire(&session->buffers);
+        if (!rob.slot_data[i]) {
+            if (verbosity >= 2) {
+                printf("Error: Cannot allocate memory for reorder buffer\n");
+            }
+            for (int j = 0; j < i; j++) {
+                buffer_pool_release(&session->buffers, rob.slot_data[j]);
+            }
+            pthread_mutex_destroy(&rob.mutex);
+            pthread_cond_destroy(&rob.window_advanced);
+            pthread_cond_destroy(&rob.block_landed);
+            return;
         }
     }
     
-    print_results("Sequential mmap", hash_xor, total_bytes, t0);
-    unmap_file(mapped_file, file_size);
-}
-// Random access pattern using memory mapping
-void random_mmap(String filename) {
-    struct timespec t0;
-    size_t file_size;
-    
-    if (verbosity >= 2) {
-        printf("Random mmap: %s\n", filename);
-    }
-    
-    void *mapped_file = map_file(filename, &file_size);
-    if (!mapped_file) {
-        return;
+    // Readers open the file on their own cores, then wait at the gate until
+    // timing starts
+    thread_pool_reserve(&session->pool, params->readers);
+    StartGate gate;
+    start_gate_init(&gate);
+    TaskGroup readers;
+    task_group_init(&readers);
+    OrderedReaderArgs reader_args[MAX_READERS];
+    int started = 0;
+    for (int i = 0; i < params->readers; i++) {
+        reader_args[i].filename = filename;
+        reader_args[i].rob = &rob;
+        reader_args[i].gate = &gate;
+        reader_args[i].reader_id = i;
+        if (thread_pool_submit(&session->pool, &readers, ordered_reader_thread, &reader_args[i])) {
+            started++;
+        } else if (verbosity >= 2) {
+            fprintf(stderr, "Error: Failed to start reader %d\n", i);
+        }
     }
-    
-    size_t num_blocks = (file_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
-    if (verbosity >= 2) {
-        printf("Number of blocks: %zu\n", num_blocks);
+    if (started == 0) {
+        rob.failed = 1;
     }
+    t0 = start_gate_open(&gate, started, result);
     
-    setup_hashing();
+    // In-order consumer runs on this thread
     uint64_t hash_xor = 0;
-    
-    unsigned char *file_ptr = (unsigned char*)mapped_file;
+    uint64_t stream_crc = 0;
     size_t total_bytes = 0;
-    t0 = timer_start();
-    
-    // Process blocks in alternating pattern
-    for (size_t i = 0; i < (num_blocks + 1) / 2; i++) {
-        size_t first_block = i;
-        size_t last_block = num_blocks - 1 - i;
+    for (size_t block = 0; block < rob.total_blocks; block++) {
+        int slot = block % rob.window;
         
-        // Process first block
-        if (first_block < num_blocks) {
-            size_t offset = first_block * BLOCK_SIZE;
-            size_t block_size = (offset + BLOCK_SIZE > file_size) ? 
-                               (file_size - offset) : BLOCK_SIZE;
-            
-            process_block_xor(file_ptr + offset, block_size, &hash_xor);
-            total_bytes += block_size;
-            
-            if (verbosity >= 2) {
-                printf("Processed block %zu (offset %zu, size %zu)\n", 
-                       first_block, offset, block_size);
+        lock_mutex(&rob.mutex);
+        if (!rob.slot_ready[slot] && !rob.failed) {
+            // Count a stall only when a later block arrived first
+            int buffered = 0;
+            for (int i = 0; i < rob.window; i++) {
+                buffered += rob.slot_ready[i];
+            }
+            struct timespec wait_start = timer_start();
+            uint64_t phase_start = span_begin();
+            while (!rob.slot_ready[slot] && !rob.failed) {
+                pthread_cond_wait(&rob.block_landed, &rob.mutex);
             }
+            span_end(SPAN_REORDER_WAIT, phase_start);
+            if (buffered > 0) {
+                rob.stalls++;
+                rob.stall_seconds += timer_elapsed(wait_start);
+            }
+        }
+        if (rob.failed && !rob.slot_ready[slot]) {
+            pthread_mutex_unlock(&rob.mutex);
+            break;
         }
+        pthread_mutex_unlock(&rob.mutex);
         
-        // Process last block (if different from first)
-        if (last_block != first_block && last_block < num_blocks) {
-            size_t offset = last_block * BLOCK_SIZE;
-            size_t block_size = (offset + BLOCK_SIZE > file_size) ? 
-                               (file_size - offset) : BLOCK_SIZE;
-            
-            process_block_xor(file_ptr + offset, block_size, &hash_xor);
-            total_bytes += block_size;
-            
-            if (verbosity >= 2) {
-                printf("Processed block %zu (offset %zu, size %zu)\n", 
-                       last_block, offset, block_size);
-            }
+        // Block CRC feeds the XOR hash; combining it in file order yields the
+        // CRC64 of the whole file
+        size_t size = rob.slot_size[slot];
+        uint64_t hash_start = span_begin();
+        uint64_t block_hash = crc64_compute(rob.slot_data[slot], size);
+        span_end(SPAN_HASH, hash_start);
+        progress_add(size);
+        hash_xor ^= block_hash;
+        stream_crc = crc64_combine(stream_crc, block_hash, size);
+        total_bytes += size;
+        
+        if (verbosity >= 2) {
+            printf("Consumed block %zu in order (size %zu)\n", block, size);
         }
+        
+        lock_mutex(&rob.mutex);
+        rob.slot_ready[slot] = 0;
+        rob.next_deliver++;
+        progress_set_depth((int)(rob.next_claim - rob.next_deliver));
+        pthread_cond_broadcast(&rob.window_advanced);
+        pthread_mutex_unlock(&rob.mutex);
     }
     
-    print_results("Random mmap", hash_xor, total_bytes, t0);
-    unmap_file(mapped_file, file_size);
+    task_group_wait(&readers);
+    result->worker_cpu_seconds = readers.cpu_seconds - gate.setup_cpu_seconds;
+    task_group_destroy(&readers);
+    start_gate_destroy(&gate);
+    
+    if (rob.failed) {
+        cpu_timer_stop(result);   // failed runs are not reported
+        if (verbosity >= 0) {
+            printf("Ordered async read: read failed after %zu of %zu bytes, skipped\n",
+                   total_bytes, file_size);
+        }
+    } else {
+        if (verbosity >= 1) {
+            printf("Stream CRC64: %016llx\n", (unsigned long long)stream_crc);
+        }
+        print_results("Ordered async read", hash_xor, total_bytes, file_size, t0, result);
+        if (verbosity >= 1) {
+            printf("  Out-of-order stalls: %zu (%f seconds), peak buffered blocks: %d of %d\n",
+                   rob.stalls, rob.stall_seconds, rob.peak_buffered, rob.window);
+        }
+    }
+    
+    for (int i = 0; i < rob.window; i++) {
+        buffer_pool_release(&session->buffers, rob.slot_data[i]);
+    }
+    pthread_mutex_destroy(&rob.mutex);
+    pthread_cond_destroy(&rob.window_advanced);
+    pthread_cond_destroy(&rob.block_landed);
 }
 
-// ============================================================================
-// Main Functions
-// ============================================================================
+// Ordered pipeline reader: claims the next block inside the window and reads
+// it straight into its reorder slot
+void* ordered_reader_thread(void *arg) {
+    OrderedReaderArgs *args = (OrderedReaderArgs*)arg;
+    ReorderBuffer *rob = args->rob;
+    struct timespec setup_start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &setup_start);
+    place_thread(2 * args->reader_id);
+    
+    FILE *file = fopen(args->filename, "rb");
+    start_gate_arrive(args->gate, setup_start);
+    if (!file) {
+        if (verbosity >= 2) {
+            printf("Reader %d: Error opening file %s\n", args->reader_id, args->filename);
+        }
+        lock_mutex(&rob->mutex);
+        rob->failed = 1;
+        pthread_cond_broadcast(&rob->block_landed);
+        pthread_mutex_unlock(&rob->mutex);
+        return NULL;
+    }
+    
+    while (1) {
+        uint64_t claim_start = span_begin();
+        lock_mutex(&rob->mutex);
+        // Bounded lookahead: never run more than a window ahead of the consumer
+        if (rob->next_claim < rob->total_blocks && !rob->failed &&
+            rob->next_claim >= rob->next_deliver + rob->window) {
+            uint64_t wait_start = span_begin();
+            while (rob->next_claim < rob->total_blocks && !rob->failed &&
+                   rob->next_claim >= rob->next_deliver + rob->window) {
+                pthread_cond_wait(&rob->window_advanced, &rob->mutex);
+            }
+            span_end(SPAN_WINDOW_WAIT, wait_start);
+        }
+        if (rob->next_claim >= rob->total_blocks || rob->failed) {
+            pthread_mutex_unlock(&rob->mutex);
+            break;
+        }
+        size_t block_index = rob->next_claim++;
+        progress_set_depth((int)(rob->next_claim - rob->next_deliver));
+        pthread_mutex_unlock(&rob->mutex);
+        span_end(SPAN_CLAIM, claim_start);
+        
+        int slot = block_index % rob->window;
+        size_t offset = block_index * rob->block_size;
+        size_t bytes_to_read = rob->block_size;
+        if (offset + bytes_to_read > rob->file_size) {
+            bytes_to_read = rob->file_size - offset;
+        }
+        
+        size_t bytes_read = 0;
+        if (fseek(file, offset, SEEK_SET) == 0) {
+            bytes_read = read_block(rob->slot_data[slot], bytes_to_read, file);
+        }
+        
+        lock_mutex(&rob->mutex);
+        if (bytes_read == 0) {
+            rob->failed = 1;
+        } else {
+            rob->slot_size[slot] = bytes_read;
+            rob->slot_ready[slot] = 1;
+            int buffered = 0;
+            for (int i = 0; i < rob->window; i++) {
+                buffered += rob->slot_ready[i];
+            }
+            if (buffered > rob->peak_buffered) {
+                rob->peak_buffered = buffered;
+            }
+        }
+        pthread_cond_broadcast(&rob->block_landed);
+        pthread_cond_broadcast(&rob->window_advanced);
+        pthread_mutex_unlock(&rob->mutex);
+        
+        if (bytes_read == 0) {
+            break;
+        }
+        if (verbosity >= 2) {
+            printf("Reader %d: Buffered block %zu (offset %zu, size %zu)\n",
+                   args->reader_id, block_index, offset, bytes_read);
+        }
+    }
+    
+    fclose(file);
+    return NULL;
+}
+
+// Queue the read of one block (or its unread remainder) into a slot
+static int uring_queue_block(UringQueue *ring, int fd, UringSlot *slot, int slot_index) {
+    return uring_prep_read(ring, fd, slot->buffer + slot->done,
+                           (unsigned)(slot->expected - slot->done),
+                           (off_t)(slot->offset + slot->done), (uint64_t)slot_index);
+}
+
+// Single-threaded event loop: io_uring keeps queue_depth block reads in
+// flight while this thread hashes whichever block completes; no locks, no
+// semaphores, no other threads
+void event_loop_read(BenchSession *session, String filename, const MethodParams *params,
+                     MethodResult *result) {
+    struct timespec t0;
+    size_t file_size;
+    
+    if (verbosity >= 2) {
+        printf("Event-loop read with queue depth %d: %s\n", params->queue_depth, filename);
+    }
+    
+    if (!get_file_size(filename, &file_size)) {
+        return;
+    }
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot open file %s\n", filename);
+        }
+        return;
+    }
+    
+    UringQueue ring;
+    int depth = params->queue_depth;
+    if (!uring_init(&ring, depth)) {
+        if (verbosity >= 0) {
+            printf("Event-loop read: io_uring unavailable (%s), skipped\n", strerror(errno));
+        }
+        close(fd);
+        return;
+    }
+    
+    setup_hashing();
+    size_t total_blocks = (file_size + params->block_size - 1) / params->block_size;
+    UringSlot slots[MAX_URING_DEPTH];
+    for (int i = 0; i < depth; i++) {
+        // Slots past the file's last block are never primed
+        slots[i].buffer = (size_t)i < total_blocks ? buffer_pool_acquire(&session->buffers) : NULL;
+    }
+    
+    size_t next_block = 0;
+    size_t total_bytes = 0;
+    uint64_t hash_xor = 0;
+    int in_flight = 0;
+    int failed = 0;   // errno of the first failure
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    // Prime the ring with the first blocks
+    for (int i = 0; i < depth && next_block < total_blocks; i++) {
+        slots[i].block_index = next_block++;
+        slots[i].offset = slots[i].block_index * params->block_size;
+        slots[i].expected = (slots[i].offset + params->block_size > file_size) ?
+                            (file_size - slots[i].offset) : params->block_size;
+        slots[i].done = 0;
+        slots[i].read_start = span_begin();
+        if (!uring_queue_block(&ring, fd, &slots[i], i)) {
+            failed = EBUSY;
+            break;
+        }
+        in_flight++;
+    }
+    if (uring_submit(&ring) < 0 && !failed) {
+        failed = errno;
+    }
+    progress_set_depth(in_flight);
+    
+    while (in_flight > 0 && !failed) {
+        uint64_t slot_index;
+        int res;
+        uint64_t wait_start = span_begin();
+        int reaped = uring_wait(&ring, &slot_index, &res);
+        span_end(SPAN_URING_WAIT, wait_start);
+        if (!reaped) {
+            failed = errno ? errno : EIO;
+            break;
+        }
+        UringSlot *slot = &slots[slot_index];
+        if (res < 0) {
+            if (verbosity >= 2) {
+                printf("Error: Read of block %zu failed (%s)\n", slot->block_index, strerror(-res));
+            }
+            in_flight--;
+            failed = -res;
+            break;
+        }
+        
+        // Short read: queue the remainder of the block and keep going
+        slot->done += res;
+        if (res > 0 && slot->done < slot->expected) {
+            if (!uring_queue_block(&ring, fd, slot, (int)slot_index)) {
+                in_flight--;
+                failed = EBUSY;
+            } else if (uring_submit(&ring) < 0) {
+                failed = errno;
+            }
+            continue;
+        }
+        in_flight--;
+        progress_set_depth(in_flight);
+        span_end(SPAN_URING_READ, slot->read_start);
+        
+        // Hash while the other slots' reads are still in flight
+        process_block_xor(slot->buffer, slot->done, &hash_xor);
+        total_bytes += slot->done;
+        if (verbosity >= 2) {
+            printf("Processed block %zu (offset %zu, size %zu)\n",
+                   slot->block_index, slot->offset, slot->done);
+        }
+        
+        // Reuse the slot for the next block
+        if (next_block < total_blocks) {
+            slot->block_index = next_block++;
+            slot->offset = slot->block_index * params->block_size;
+            slot->expected = (slot->offset + params->block_size > file_size) ?
+                             (file_size - slot->offset) : params->block_size;
+            slot->done = 0;
+            slot->read_start = span_begin();
+            if (!uring_queue_block(&ring, fd, slot, (int)slot_index)) {
+                failed = EBUSY;
+                break;
+            }
+            in_flight++;
+            progress_set_depth(in_flight);
+            if (uring_submit(&ring) < 0) {
+                failed = errno;
+            }
+        }
+    }
+    
+    // Drain reads still in flight after an error before releasing buffers
+    while (failed && in_flight > 0) {
+        uint64_t slot_index;
+        int res;
+        if (!uring_wait(&ring, &slot_index, &res)) {
+            break;
+        }
+        in_flight--;
+    }
+    
+    if (failed) {
+        cpu_timer_stop(result);   // failed runs are not reported
+        if (verbosity >= 0) {
+            printf("Event-loop read: read failed (%s), skipped\n", strerror(failed));
+        }
+    } else {
+        print_results("Event-loop read", hash_xor, total_bytes, file_size, t0, result);
+    }
+    
+    for (int i = 0; i < depth; i++) {
+        buffer_pool_release(&session->buffers, slots[i].buffer);
+    }
+    uring_destroy(&ring);
+    close(fd);
+}
+
+// Random small reads at a fixed queue depth: each thread keeps queue_depth
+// reads of block_size bytes in flight at random block-aligned offsets
+// (io_uring, or one pread at a time without it) and hashes every block read
+void iops_read(BenchSession *session, String filename, const MethodParams *params,
+               MethodResult *result) {
+    struct timespec t0;
+    size_t file_size;
+    
+    if (verbosity >= 2) {
+        printf("Random IOPS with %d threads, queue depth %d, %zu-byte reads%s: %s\n",
+               params->workers, params->queue_depth, params->block_size,
+               params->direct ? " (O_DIRECT)" : "", filename);
+    }
+    
+    if (!get_file_size(filename, &file_size)) {
+        return;
+    }
+    if (file_size < params->block_size) {
+        if (verbosity >= 0) {
+            printf("Random IOPS: file is smaller than one %zu-byte read, skipped\n", params->block_size);
+        }
+        return;
+    }
+    
+    setup_hashing();
+    int num_workers = params->workers;
+    IopsArgs *args = calloc(num_workers, sizeof(IopsArgs));
+    LatencyHistogram *latency = calloc(1, sizeof(LatencyHistogram));
+    if (!args || !latency) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot allocate memory for IOPS threads\n");
+        }
+        free(args);
+        free(latency);
+        return;
+    }
+    StartGate gate;
+    start_gate_init(&gate);
+    uint64_t seeds = access_seed;
+    for (int i = 0; i < num_workers; i++) {
+        args[i].filename = filename;
+        args[i].gate = &gate;
+        args[i].worker_id = i;
+        args[i].file_size = file_size;
+        args[i].io_size = params->block_size;
+        args[i].ops = params->ops * (i + 1) / num_workers - params->ops * i / num_workers;
+        args[i].queue_depth = params->queue_depth;
+        args[i].direct = params->direct;
+        args[i].seed = stats_random(&seeds);
+        latency_histogram_reset(&args[i].latency);
+    }
+    
+    // Threads open the file, fault in their buffers and set up their rings
+    // on their own cores, then wait at the gate until timing starts
+    thread_pool_reserve(&session->pool, num_workers);
+    TaskGroup workers;
+    task_group_init(&workers);
+    int started = 0;
+    for (int i = 0; i < num_workers; i++) {
+        if (thread_pool_submit(&session->pool, &workers, iops_worker, &args[i])) {
+            started++;
+        } else if (verbosity >= 2) {
+            fprintf(stderr, "Error: Failed to start IOPS thread %d\n", i);
+        }
+    }
+    t0 = start_gate_open(&gate, started, result);
+    task_group_wait(&workers);
+    result->worker_cpu_seconds = workers.cpu_seconds - gate.setup_cpu_seconds;
+    task_group_destroy(&workers);
+    start_gate_destroy(&gate);
+    
+    uint64_t hash_xor = 0;
+    size_t total_bytes = 0;
+    size_t completed = 0;
+    int error = 0;
+    int no_uring = 0;
+    size_t node_bytes[TOPOLOGY_MAX_NODES] = {0};
+    latency_histogram_reset(latency);
+    for (int i = 0; i < num_workers; i++) {
+        hash_xor ^= args[i].hash_xor;
+        total_bytes += args[i].total_bytes;
+        completed += args[i].completed;
+        error = error ? error : args[i].error;
+        no_uring |= args[i].no_uring;
+        node_bytes[args[i].node] += args[i].total_bytes;
+        latency_histogram_merge(latency, &args[i].latency);
+    }
+    double elapsed = timer_elapsed(t0);
+    
+    if (error && verbosity >= 0) {
+        printf("Random IOPS: read failed (%s)%s\n", strerror(error),
+               error == EINVAL && params->direct ? "; the filesystem may not support O_DIRECT" : "");
+    }
+    if (completed < params->ops) {
+        if (!error && verbosity >= 0) {
+            printf("Random IOPS: only %zu of %zu reads completed, skipped\n", completed, params->ops);
+        }
+        cpu_timer_stop(result);   // incomplete runs are not reported
+        free(args);
+        free(latency);
+        return;
+    }
+    if (no_uring && verbosity >= 1) {
+        printf("Random IOPS: io_uring unavailable, one pread in flight per thread\n");
+    }
+    
+    result->ops = completed;
+    phase_summarize(latency, &result->op_latency);
+    print_results("Random IOPS", hash_xor, total_bytes, params->ops * params->block_size, t0, result);
+    if (verbosity >= 0) {
+        printf("  IOPS: %.0f (%zu reads of %zu bytes, %d threads x depth %d%s)\n",
+               completed / result->seconds, completed, params->block_size, num_workers,
+               no_uring ? 1 : params->queue_depth, params->direct ? ", O_DIRECT" : "");
+        const PhaseLatency *l = &result->op_latency;
+        printf("  Read latency: mean %.1f  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f us\n",
+               l->mean / 1e3, l->p50 / 1e3, l->p90 / 1e3, l->p99 / 1e3, l->p999 / 1e3, l->max / 1e3);
+    }
+    print_node_throughput(node_bytes, elapsed);
+    free(args);
+    free(latency);
+}
+
+// Block-aligned random offset at which a whole read fits in the file
+static inline off_t iops_offset(IopsArgs *args) {
+    size_t positions = args->file_size / args->io_size;
+    return (off_t)((stats_random(&args->seed) % positions) * args->io_size);
+}
+
+void* iops_worker(void *arg) {
+    IopsArgs *args = (IopsArgs*)arg;
+    struct timespec setup_start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &setup_start);
+    args->node = place_thread(args->worker_id);
+    
+    // Everything up to the gate is setup, outside the timed region
+    int depth = args->queue_depth;
+    int fd = open(args->filename, O_RDONLY | (args->direct ? O_DIRECT : 0));
+    if (fd == -1) {
+        args->error = errno;
+        depth = 0;
+    }
+    
+    // O_DIRECT needs buffers aligned to the device's logical block size;
+    // faulted in by this thread so first-touch places them on its node
+    unsigned char *buffers[MAX_URING_DEPTH] = {NULL};
+    uint64_t started[MAX_URING_DEPTH];
+    for (int i = 0; i < depth; i++) {
+        void *buffer;
+        if (posix_memalign(&buffer, IOPS_ALIGNMENT, args->io_size) != 0) {
+            args->error = ENOMEM;
+            depth = i;
+            break;
+        }
+        memset(buffer, 0, args->io_size);
+        buffers[i] = buffer;
+    }
+    
+    UringQueue ring;
+    if (depth > 0 && !args->error && !uring_init(&ring, depth)) {
+        args->no_uring = 1;
+    }
+    
+    start_gate_arrive(args->gate, setup_start);
+    
+    if (args->error) {
+        // Nothing more to do
+    } else if (args->no_uring) {
+        for (size_t op = 0; op < args->ops; op++) {
+            off_t offset = iops_offset(args);
+            uint64_t start = now_ns();
+            ssize_t bytes_read = pread(fd, buffers[0], args->io_size, offset);
+            latency_histogram_record(&args->latency, now_ns() - start);
+            span_end(SPAN_READ, start);
+            if (bytes_read <= 0) {
+                args->error = bytes_read < 0 ? errno : EIO;
+                break;
+            }
+            process_block_xor(buffers[0], bytes_read, &args->hash_xor);
+            args->total_bytes += bytes_read;
+            args->completed++;
+        }
+    } else {
+        size_t issued = 0;
+        int in_flight = 0;
+        for (int i = 0; i < depth && issued < args->ops; i++, issued++) {
+            started[i] = now_ns();
+            if (!uring_prep_read(&ring, fd, buffers[i], (unsigned)args->io_size,
+                                 iops_offset(args), (uint64_t)i)) {
+                args->error = EBUSY;
+                break;
+            }
+            in_flight++;
+        }
+        if (uring_submit(&ring) < 0 && !args->error) {
+            args->error = errno;
+        }
+        
+        while (in_flight > 0 && !args->error) {
+            uint64_t slots[MAX_URING_DEPTH];
+            int results[MAX_URING_DEPTH];
+            uint64_t wait_start = span_begin();
+            if (!uring_wait(&ring, &slots[0], &results[0])) {
+                args->error = errno ? errno : EIO;
+                break;
+            }
+            span_end(SPAN_URING_WAIT, wait_start);
+            
+            // Timestamp every completion already waiting before hashing any,
+            // so one block's hash does not count toward another's latency
+            int reaped = 0;
+            do {
+                uint64_t slot = slots[reaped];
+                latency_histogram_record(&args->latency, now_ns() - started[slot]);
+                span_end(SPAN_URING_READ, started[slot]);
+                in_flight--;
+                reaped++;
+            } while (reaped < depth && uring_peek(&ring, &slots[reaped], &results[reaped]));
+            
+            for (int i = 0; i < reaped; i++) {
+                uint64_t slot = slots[i];
+                int res = results[i];
+                if (res <= 0) {
+                    args->error = res < 0 ? -res : EIO;
+                    break;
+                }
+                
+                // Hash while the other reads are in flight
+                process_block_xor(buffers[slot], res, &args->hash_xor);
+                args->total_bytes += res;
+                args->completed++;
+                
+                if (issued < args->ops) {
+                    started[slot] = now_ns();
+                    if (!uring_prep_read(&ring, fd, buffers[slot], (unsigned)args->io_size,
+                                         iops_offset(args), slot)) {
+                        args->error = EBUSY;
+                        break;
+                    }
+                    in_flight++;
+                    issued++;
+                }
+            }
+            if (uring_submit(&ring) < 0 && !args->error) {
+                args->error = errno;
+            }
+        }
+        
+        // Drain reads still in flight after an error before freeing buffers
+        while (in_flight > 0) {
+            uint64_t slot;
+            int res;
+            if (!uring_wait(&ring, &slot, &res)) {
+                break;
+            }
+            in_flight--;
+        }
+        uring_destroy(&ring);
+    }
+    
+    if (verbosity >= 2) {
+        printf("IOPS thread %d: Completed %zu reads\n", args->worker_id, args->completed);
+    }
+    
+    for (int i = 0; i < depth; i++) {
+        free(buffers[i]);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+    return NULL;
+}
+
+// Standard sequential file reading
+void sequential_read(BenchSession *session, String filename, const MethodParams *params,
+                     MethodResult *result) {
+    struct timespec t0;
+    size_t file_size;
+    
+    if (verbosity >= 2) {
+        printf("Sequential read: %s\n", filename);
+    }
+    
+    if (!get_file_size(filename, &file_size)) {
+        return;
+    }
+    
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot open file %s\n", filename);
+        }
+        return;
+    }
+    
+    setup_hashing();
+    uint64_t hash_xor = 0;
+    
+    unsigned char *buffer = buffer_pool_acquire(&session->buffers);
+    if (!buffer) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot allocate memory for buffer\n");
+        }
+        fclose(file);
+        return;
+    }
+    
+    size_t bytes_read;
+    size_t total_bytes = 0;
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    // Read and hash file in blocks (order-independent XOR)
+    while ((bytes_read = read_block(buffer, params->block_size, file)) > 0) {
+        process_block_xor(buffer, bytes_read, &hash_xor);
+        total_bytes += bytes_read;
+        
+        if (verbosity >= 2) {
+            printf("Read %zu bytes (total: %zu)\n", bytes_read, total_bytes);
+        }
+    }
+    
+    print_results("Sequential read", hash_xor, total_bytes, file_size, t0, result);
+    buffer_pool_release(&session->buffers, buffer);
+    fclose(file);
+}
+
+// Block indices in visiting order (NULL if out of memory): alternating from
+// both ends toward the centre, or a permutation seeded by --access-seed
+static size_t *block_order(size_t num_blocks, AccessPattern pattern) {
+    size_t *order = malloc(num_blocks * sizeof(size_t));
+    if (!order) {
+        return NULL;
+    }
+    if (pattern == ACCESS_PERMUTED) {
+        uint64_t state = access_seed;
+        stats_permutation(order, num_blocks, &state);
+    } else {
+        // first, last, second, second-to-last, etc.
+        for (size_t i = 0, k = 0; k < num_blocks; i++) {
+            order[k++] = i;
+            if (k < num_blocks) {
+                order[k++] = num_blocks - 1 - i;
+            }
+        }
+    }
+    return order;
+}
+
+// Read and hash the blocks in the given order, one seek per block
+static void block_order_read(BenchSession *session, String filename, const MethodParams *params,
+                             MethodResult *result, AccessPattern pattern, const char *name) {
+    struct timespec t0;
+    size_t file_size;
+    
+    if (verbosity >= 2) {
+        printf("%s: %s\n", name, filename);
+    }
+    
+    if (!get_file_size(filename, &file_size)) {
+        return;
+    }
+    
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot open file %s\n", filename);
+        }
+        return;
+    }
+    
+    size_t num_blocks = (file_size + params->block_size - 1) / params->block_size;
+    if (verbosity >= 2) {
+        printf("Number of blocks: %zu\n", num_blocks);
+    }
+    
+    setup_hashing();
+    uint64_t hash_xor = 0;
+    
+    size_t *order = block_order(num_blocks, pattern);
+    unsigned char *buffer = buffer_pool_acquire(&session->buffers);
+    if (!order || !buffer) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot allocate memory for buffer\n");
+        }
+        free(order);
+        if (buffer) {
+            buffer_pool_release(&session->buffers, buffer);
+        }
+        fclose(file);
+        return;
+    }
+    
+    size_t total_bytes = 0;
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    for (size_t i = 0; i < num_blocks; i++) {
+        size_t offset = order[i] * params->block_size;
+        size_t block_size = (offset + params->block_size > file_size) ? 
+                           (file_size - offset) : params->block_size;
+        
+        fseek(file, offset, SEEK_SET);
+        size_t bytes_read = read_block(buffer, block_size, file);
+        
+        if (bytes_read > 0) {
+            process_block_xor(buffer, bytes_read, &hash_xor);
+            total_bytes += bytes_read;
+            if (verbosity >= 2) {
+                printf("Read block %zu (offset %zu, size %zu)\n", 
+                       order[i], offset, bytes_read);
+            }
+        }
+    }
+    
+    print_results(name, hash_xor, total_bytes, file_size, t0, result);
+    buffer_pool_release(&session->buffers, buffer);
+    free(order);
+    fclose(file);
+}
+
+// Random access pattern: every block once, in a seeded random order
+void random_read(BenchSession *session, String filename, const MethodParams *params,
+                 MethodResult *result) {
+    block_order_read(session, filename, params, result, ACCESS_PERMUTED, "Random read");
+}
+
+// Alternating from ends toward center (two sequential streams for readahead)
+void alternating_read(BenchSession *session, String filename, const MethodParams *params,
+                      MethodResult *result) {
+    block_order_read(session, filename, params, result, ACCESS_ALTERNATING, "Alternating read");
+}
+
+// ============================================================================
+// Memory-Mapped File Functions
+// ============================================================================
+
+// Sequential processing using memory mapping
+void sequential_mmap(BenchSession *session, String filename, const MethodParams *params,
+                     MethodResult *result) {
+    (void)session;  // maps the file, needs no buffers
+    struct timespec t0;
+    size_t file_size;
+    
+    if (verbosity >= 2) {
+        printf("Sequential mmap: %s\n", filename);
+    }
+    
+    void *mapped_file = map_file(filename, &file_size);
+    if (!mapped_file) {
+        return;
+    }
+    
+    setup_hashing();
+    uint64_t hash_xor = 0;
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    // Process file in blocks from mapped memory
+    unsigned char *file_ptr = (unsigned char*)mapped_file;
+    size_t offset = 0;
+    size_t total_bytes = 0;
+    
+    while (offset < file_size) {
+        size_t block_size = (offset + params->block_size > file_size) ? 
+                           (file_size - offset) : params->block_size;
+        
+        process_block_xor(file_ptr + offset, block_size, &hash_xor);
+        total_bytes += block_size;
+        offset += block_size;
+        
+        if (verbosity >= 2) {
+            printf("Processed %zu bytes (total: %zu)\n", block_size, total_bytes);
+        }
+    }
+    
+    print_results("Sequential mmap", hash_xor, total_bytes, file_size, t0, result);
+    unmap_file(mapped_file, file_size);
+}
+// Hash the mapped blocks in the given order
+static void block_order_mmap(String filename, const MethodParams *params, MethodResult *result,
+                             AccessPattern pattern, const char *name) {
+    struct timespec t0;
+    size_t file_size;
+    
+    if (verbosity >= 2) {
+        printf("%s: %s\n", name, filename);
+    }
+    
+    void *mapped_file = map_file(filename, &file_size);
+    if (!mapped_file) {
+        return;
+    }
+    
+    size_t num_blocks = (file_size + params->block_size - 1) / params->block_size;
+    if (verbosity >= 2) {
+        printf("Number of blocks: %zu\n", num_blocks);
+    }
+    
+    size_t *order = block_order(num_blocks, pattern);
+    if (!order) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot allocate memory for block order\n");
+        }
+        unmap_file(mapped_file, file_size);
+        return;
+    }
+    
+    setup_hashing();
+    uint64_t hash_xor = 0;
+    unsigned char *file_ptr = (unsigned char*)mapped_file;
+    size_t total_bytes = 0;
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    for (size_t i = 0; i < num_blocks; i++) {
+        size_t offset = order[i] * params->block_size;
+        size_t block_size = (offset + params->block_size > file_size) ? 
+                           (file_size - offset) : params->block_size;
+        
+        process_block_xor(file_ptr + offset, block_size, &hash_xor);
+        total_bytes += block_size;
+        
+        if (verbosity >= 2) {
+            printf("Processed block %zu (offset %zu, size %zu)\n", 
+                   order[i], offset, block_size);
+        }
+    }
+    
+    print_results(name, hash_xor, total_bytes, file_size, t0, result);
+    free(order);
+    unmap_file(mapped_file, file_size);
+}
+
+// Random access pattern using memory mapping
+void random_mmap(BenchSession *session, String filename, const MethodParams *params,
+                 MethodResult *result) {
+    (void)session;  // maps the file, needs no buffers
+    block_order_mmap(filename, params, result, ACCESS_PERMUTED, "Random mmap");
+}
+
+// Alternating pattern using memory mapping
+void alternating_mmap(BenchSession *session, String filename, const MethodParams *params,
+                      MethodResult *result) {
+    (void)session;
+    block_order_mmap(filename, params, result, ACCESS_ALTERNATING, "Alternating mmap");
+}
+
+// ============================================================================
+// In-memory baselines
+// ============================================================================
+
+// The file loaded into memory (faulted in by the load itself) for the
+// baseline run in progress
+static unsigned char *memory_image = NULL;
+static size_t memory_image_size = 0;
+
+// Loaded before each baseline run's timed region and freed after it, so the
+// image only occupies memory while a baseline runs
+static int load_memory_image(const char *filename) {
+    size_t file_size;
+    if (!get_file_size(filename, &file_size)) {
+        return 0;
+    }
+    // An image that does not stay resident would measure swapping instead
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0 && file_size > (size_t)pages * page_size / 2) {
+        if (verbosity >= 1) {
+            printf("Skipping in-memory baseline: file is larger than half of RAM\n");
+        }
+        return 0;
+    }
+    unsigned char *image = malloc(file_size);
+    FILE *file = fopen(filename, "rb");
+    if (!image || !file) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot load %s into memory\n", filename);
+        }
+        free(image);
+        if (file) {
+            fclose(file);
+        }
+        return 0;
+    }
+    size_t loaded = 0;
+    size_t bytes_read;
+    while (loaded < file_size &&
+           (bytes_read = fread(image + loaded, 1, file_size - loaded, file)) > 0) {
+        loaded += bytes_read;
+    }
+    fclose(file);
+    if (loaded != file_size) {
+        if (verbosity >= 2) {
+            printf("Error: Short read loading %s into memory\n", filename);
+        }
+        free(image);
+        return 0;
+    }
+    memory_image = image;
+    memory_image_size = file_size;
+    return 1;
+}
+
+static void free_memory_image(void) {
+    free(memory_image);
+    memory_image = NULL;
+    memory_image_size = 0;
+}
+
+// Compute ceiling: the block loop of the mmap methods over memory that is
+// already loaded, so nothing but hashing is timed
+void memory_hash(BenchSession *session, String filename, const MethodParams *params,
+                 MethodResult *result) {
+    (void)session;
+    struct timespec t0;
+    
+    if (verbosity >= 2) {
+        printf("In-memory hash: %s\n", filename);
+    }
+    
+    if (!load_memory_image(filename)) {
+        return;
+    }
+    
+    setup_hashing();
+    uint64_t hash_xor = 0;
+    size_t total_bytes = 0;
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    for (size_t offset = 0; offset < memory_image_size; offset += params->block_size) {
+        size_t block_size = (offset + params->block_size > memory_image_size) ?
+                           (memory_image_size - offset) : params->block_size;
+        process_block_xor(memory_image + offset, block_size, &hash_xor);
+        total_bytes += block_size;
+    }
+    
+    print_results("In-memory hash", hash_xor, total_bytes, memory_image_size, t0, result);
+    free_memory_image();
+}
+
+// Memory-bandwidth ceiling: each block of the loaded file copied into a
+// session buffer, the copy a read() does from the page cache (no hash)
+void memory_copy(BenchSession *session, String filename, const MethodParams *params,
+                 MethodResult *result) {
+    struct timespec t0;
+    
+    if (verbosity >= 2) {
+        printf("In-memory memcpy: %s\n", filename);
+    }
+    
+    if (!load_memory_image(filename)) {
+        return;
+    }
+    
+    unsigned char *buffer = buffer_pool_acquire(&session->buffers);
+    if (!buffer) {
+        if (verbosity >= 2) {
+            printf("Error: Cannot allocate memory for buffer\n");
+        }
+        free_memory_image();
+        return;
+    }
+    
+    size_t total_bytes = 0;
+    cpu_timer_start(result);
+    t0 = timer_start();
+    
+    for (size_t offset = 0; offset < memory_image_size; offset += params->block_size) {
+        size_t block_size = (offset + params->block_size > memory_image_size) ?
+                           (memory_image_size - offset) : params->block_size;
+        memcpy(buffer, memory_image + offset, block_size);
+        progress_add(block_size);
+        total_bytes += block_size;
+    }
+    
+    result->unhashed = 1;
+    print_results("In-memory memcpy", 0, total_bytes, memory_image_size, t0, result);
+    buffer_pool_release(&session->buffers, buffer);
+    free_memory_image();
+}
+
+// ============================================================================
+// Main Functions
+// ============================================================================
+
+// Parse a whole byte count with an optional K/M/G suffix (binary units)
+static int parse_size(const char *text, size_t *size) {
+    char *end;
+    if (*text < '0' || *text > '9') {   // strtoull would skip spaces and negate "-1"
+        return 0;
+    }
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (errno == ERANGE) {
+        return 0;
+    }
+    unsigned long long unit = 1;
+    switch (*end) {
+    case 'k': case 'K': unit = 1024ULL; end++; break;
+    case 'm': case 'M': unit = 1024ULL * 1024; end++; break;
+    case 'g': case 'G': unit = 1024ULL * 1024 * 1024; end++; break;
+    default: break;
+    }
+    if (*end == 'B' || *end == 'b') {
+        end++;
+    }
+    if (*end != '\0' || value > SIZE_MAX / unit) {
+        return 0;
+    }
+    *size = (size_t)(value * unit);
+    return 1;
+}
+
+// Parse a whole decimal int; no trailing text
+static int parse_int(const char *text, int *number) {
+    char *end;
+    errno = 0;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+        return 0;
+    }
+    *number = (int)value;
+    return 1;
+}
+
+// Parse a 64-bit seed (decimal, 0x hex or 0 octal); no sign, no trailing text
+static int parse_seed(const char *text, uint64_t *seed) {
+    char *end;
+    if (*text < '0' || *text > '9') {   // strtoull would skip spaces and negate "-1"
+        return 0;
+    }
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 0);
+    if (end == text || *end != '\0' || errno == ERANGE) {
+        return 0;
+    }
+    *seed = value;
+    return 1;
+}
+
+typedef void (*MethodFunc)(BenchSession *session, String filename, const MethodParams *params,
+                           MethodResult *result);
+
+// Overrides a method accepts besides block=
+#define PARAM_READERS   0x01
+#define PARAM_CONSUMERS 0x02
+#define PARAM_WORKERS   0x04
+#define PARAM_WINDOW    0x08
+#define PARAM_DEPTH     0x10
+#define PARAM_OPS       0x20  // also: a workload of its own, run only when named
+#define PARAM_DIRECT    0x40
+
+// Ceiling a baseline method measures
+typedef enum {
+    CEILING_NONE,        // reads the file
+    CEILING_HASH,
+    CEILING_MEMCPY,
+    CEILING_COUNT
+} Ceiling;
+
+typedef struct {
+    const char *key;     // name used by --methods
+    const char *name;
+    MethodFunc run;
+    unsigned params;     // PARAM_* overrides it accepts
+    Ceiling ceiling;
+} BenchMethod;
+
+// Every method, in the order they are run; the in-memory baselines come last
+static const BenchMethod methods[] = {
+    {"seq",     "Sequential read",       sequential_read,       0,                               CEILING_NONE},
+    {"rand",    "Random read",           random_read,           0,                               CEILING_NONE},
+    {"mmap",    "Sequential mmap",       sequential_mmap,       0,                               CEILING_NONE},
+    {"rmmap",   "Random mmap",           random_mmap,           0,                               CEILING_NONE},
+    {"alt",     "Alternating read",      alternating_read,      0,                               CEILING_NONE},
+    {"altmmap", "Alternating mmap",      alternating_mmap,      0,                               CEILING_NONE},
+    {"async",   "Async sequential read", async_sequential_read, PARAM_READERS | PARAM_CONSUMERS, CEILING_NONE},
+    {"steal",   "Work-stealing read",    work_stealing_read,    PARAM_WORKERS,                   CEILING_NONE},
+    {"ordered", "Ordered async read",    ordered_async_read,    PARAM_READERS | PARAM_WINDOW,    CEILING_NONE},
+    {"uring",   "Event-loop read",       event_loop_read,       PARAM_DEPTH,                     CEILING_NONE},
+    {"iops",    "Random IOPS",           iops_read,             PARAM_WORKERS | PARAM_DEPTH | PARAM_OPS | PARAM_DIRECT,
+                                                                                                 CEILING_NONE},
+    {"memhash", "In-memory hash",        memory_hash,           0,                               CEILING_HASH},
+    {"memcpy",  "In-memory memcpy",      memory_copy,           0,                               CEILING_MEMCPY},
+};
+#define NUM_METHODS ((int)(sizeof(methods) / sizeof(methods[0])))
+
+// One entry of the run list (--methods), with its parameters
+typedef struct {
+    const BenchMethod *method;
+    MethodParams params;
+    int block_given;     // block= was set explicitly
+    char label[96];      // method name plus any overrides
+} MethodSelection;
+
+static MethodSelection selections[MAX_SELECTED];
+static int num_selections = 0;
+
+static const MethodParams default_params = {
+    BLOCK_SIZE, NUM_READERS, NUM_CONSUMERS, NUM_WORKERS, REORDER_WINDOW, URING_QUEUE_DEPTH,
+    IOPS_OPS, 0
+};
+
+static int add_selection(const BenchMethod *method) {
+    if (num_selections >= MAX_SELECTED) {
+        printf("Error: At most %d method runs can be selected\n", MAX_SELECTED);
+        return 0;
+    }
+    MethodSelection *selection = &selections[num_selections++];
+    selection->method = method;
+    selection->params = default_params;
+    selection->block_given = 0;
+    if (method->params & PARAM_OPS) {
+        selection->params.block_size = IOPS_IO_SIZE;
+        selection->params.workers = IOPS_WORKERS;
+        selection->params.queue_depth = IOPS_QUEUE_DEPTH;
+    }
+    snprintf(selection->label, sizeof(selection->label), "%s", method->name);
+    return 1;
+}
+
+// Apply one name=value override to the last selection
+static int apply_override(MethodSelection *selection, const char *name, const char *value) {
+    const BenchMethod *method = selection->method;
+    MethodParams *params = &selection->params;
+    int number = 0;
+    int numeric = parse_int(value, &number);   // checked with each range below
+    if (strcmp(name, "block") == 0) {
+        if (!parse_size(value, &params->block_size) || params->block_size == 0 ||
+            params->block_size > MAX_BLOCK_SIZE) {
+            printf("Error: block must be between 1 and %d bytes\n", MAX_BLOCK_SIZE);
+            return 0;
+        }
+        if ((method->params & PARAM_OPS) && (params->block_size < IOPS_MIN_IO ||
+            params->block_size > IOPS_MAX_IO || params->block_size % IOPS_MIN_IO != 0)) {
+            printf("Error: %s block must be a multiple of 4K from 4K to 1M\n", method->key);
+            return 0;
+        }
+        selection->block_given = 1;
+    } else if (strcmp(name, "readers") == 0 && (method->params & PARAM_READERS)) {
+        if (!numeric || number < 1 || number > MAX_READERS) {
+            printf("Error: readers must be between 1 and %d\n", MAX_READERS);
+            return 0;
+        }
+        params->readers = number;
+    } else if (strcmp(name, "consumers") == 0 && (method->params & PARAM_CONSUMERS)) {
+        if (!numeric || number < 1 || number > MAX_CONSUMERS) {
+            printf("Error: consumers must be between 1 and %d\n", MAX_CONSUMERS);
+            return 0;
+        }
+        params->consumers = number;
+    } else if (strcmp(name, "workers") == 0 && (method->params & PARAM_WORKERS)) {
+        if (!numeric || number < 1 || number > MAX_WORKERS) {
+            printf("Error: workers must be between 1 and %d\n", MAX_WORKERS);
+            return 0;
+        }
+        params->workers = number;
+    } else if (strcmp(name, "window") == 0 && (method->params & PARAM_WINDOW)) {
+        if (!numeric || number < 1 || number > MAX_REORDER_WINDOW) {
+            printf("Error: window must be between 1 and %d\n", MAX_REORDER_WINDOW);
+            return 0;
+        }
+        params->window = number;
+    } else if (strcmp(name, "depth") == 0 && (method->params & PARAM_DEPTH)) {
+        if (!numeric || number < 1 || number > MAX_URING_DEPTH) {
+            printf("Error: depth must be between 1 and %d\n", MAX_URING_DEPTH);
+            return 0;
+        }
+        params->queue_depth = number;
+    } else if (strcmp(name, "ops") == 0 && (method->params & PARAM_OPS)) {
+        if (!numeric || number < 1 || number > MAX_IOPS_OPS) {
+            printf("Error: ops must be between 1 and %d\n", MAX_IOPS_OPS);
+            return 0;
+        }
+        params->ops = number;
+    } else if (strcmp(name, "direct") == 0 && (method->params & PARAM_DIRECT)) {
+        if (strcmp(value, "0") != 0 && strcmp(value, "1") != 0) {
+            printf("Error: direct must be 0 or 1\n");
+            return 0;
+        }
+        params->direct = number;
+    } else {
+        printf("Error: Method %s has no parameter '%s'\n", method->key, name);
+        return 0;
+    }
+    return 1;
+}
+
+// Parse "seq,async:readers=8:consumers=2,uring:depth=16" (or "all")
+static int parse_method_list(const char *list) {
+    char *copy = strdup(list);
+    if (!copy) {
+        return 0;
+    }
+    int ok = 1;
+    char *save_item;
+    for (char *item = strtok_r(copy, ",", &save_item); item && ok;
+         item = strtok_r(NULL, ",", &save_item)) {
+        char *save_field;
+        char *key = strtok_r(item, ":", &save_field);
+        if (!key) {
+            continue;
+        }
+        // Overrides apply to every selection this item adds
+        int first = num_selections;
+        if (strcmp(key, "all") == 0) {
+            for (int m = 0; m < NUM_METHODS && ok; m++) {
+                if (!(methods[m].params & PARAM_OPS)) {
+                    ok = add_selection(&methods[m]);
+                }
+            }
+        } else {
+            const BenchMethod *method = NULL;
+            for (int m = 0; m < NUM_METHODS; m++) {
+                if (strcmp(key, methods[m].key) == 0) {
+                    method = &methods[m];
+                }
+            }
+            if (!method) {
+                printf("Error: Unknown method '%s'\n", key);
+                ok = 0;
+            } else {
+                ok = add_selection(method);
+            }
+        }
+        if (!ok) {
+            break;
+        }
+        char overrides[64] = "";
+        for (char *field = strtok_r(NULL, ":", &save_field); field && ok;
+             field = strtok_r(NULL, ":", &save_field)) {
+            char *value = strchr(field, '=');
+            if (!value) {
+                printf("Error: Expected name=value in '%s'\n", field);
+                ok = 0;
+                break;
+            }
+            *value++ = '\0';
+            for (int s = first; s < num_selections && ok; s++) {
+                ok = apply_override(&selections[s], field, value);
+            }
+            size_t used = strlen(overrides);
+            snprintf(overrides + used, sizeof(overrides) - used, "%s%s=%s",
+                     used ? ", " : "", field, value);
+        }
+        for (int s = first; s < num_selections && overrides[0]; s++) {
+            snprintf(selections[s].label, sizeof(selections[s].label), "%s (%s)",
+                     selections[s].method->name, overrides);
+        }
+    }
+    free(copy);
+    return ok;
+}
+
+// Compact binary size for labels and tables ("4K", "16M", "1G")
+static void format_size(size_t size, char *text, size_t length) {
+    static const char units[] = {'G', 'M', 'K'};
+    for (int u = 0; u < 3; u++) {
+        size_t unit = (size_t)1 << (30 - 10 * u);
+        if (size >= unit && size % unit == 0) {
+            snprintf(text, length, "%zu%c", size / unit, units[u]);
+            return;
+        }
+    }
+    snprintf(text, length, "%zu", size);
+}
+
+// Replace each selection with one per sweep block size. Sizes stop at the first
+// one covering the whole file, since larger blocks read it the same way.
+static int expand_sweep(String filename) {
+    struct stat st;
+    size_t file_size = stat(filename, &st) == 0 ? (size_t)st.st_size : sweep_max;
+    num_sweep_sizes = 0;
+    for (size_t size = sweep_min; size <= sweep_max && num_sweep_sizes < MAX_SWEEP_SIZES; size *= 2) {
+        sweep_sizes[num_sweep_sizes++] = size;
+        if (size >= file_size) {
+            break;
+        }
+    }
+    if (num_selections * num_sweep_sizes > MAX_SELECTED) {
+        printf("Error: %d methods x %d block sizes exceeds %d runs; narrow --methods or --sweep-range\n",
+               num_selections, num_sweep_sizes, MAX_SELECTED);
+        return 0;
+    }
+    for (int m = 0; m < num_selections; m++) {
+        if (selections[m].method->params & PARAM_OPS) {
+            printf("Error: --sweep does not apply to %s; set its read size with block=\n",
+                   selections[m].method->key);
+            return 0;
+        }
+        if (selections[m].block_given) {
+            printf("Error: --sweep sets the block size; drop block= from %s\n",
+                   selections[m].method->key);
+            return 0;
+        }
+    }
+    
+    MethodSelection bases[MAX_SELECTED];
+    int num_bases = num_selections;
+    memcpy(bases, selections, num_bases * sizeof(MethodSelection));
+    num_selections = 0;
+    for (int b = 0; b < num_bases; b++) {
+        snprintf(sweep_labels[b], sizeof(sweep_labels[b]), "%s", bases[b].label);
+        size_t base_length = strlen(bases[b].label);
+        int has_overrides = base_length > 0 && bases[b].label[base_length - 1] == ')';
+        for (int k = 0; k < num_sweep_sizes; k++) {
+            MethodSelection *selection = &selections[num_selections++];
+            *selection = bases[b];
+            selection->params.block_size = sweep_sizes[k];
+            char size_text[24];
+            format_size(sweep_sizes[k], size_text, sizeof(size_text));
+            if (has_overrides) {
+                snprintf(selection->label, sizeof(selection->label), "%.*s, block=%s)",
+                         (int)base_length - 1, bases[b].label, size_text);
+            } else {
+                snprintf(selection->label, sizeof(selection->label), "%s (block=%s)",
+                         bases[b].label, size_text);
+            }
+        }
+    }
+    return 1;
+}
+
+static inline int min_blocks(int count, size_t blocks) {
+    return (size_t)count < blocks ? count : (int)blocks;
+}
+
+// Session buffers one run of a method takes from the pool at most, and their
+// size, so the pool fits each run instead of the hungriest method and block.
+// No method holds more buffers than the file has blocks.
+static int method_buffers(const MethodSelection *selection, size_t file_size, size_t *buffer_size) {
+    const BenchMethod *method = selection->method;
+    const MethodParams *params = &selection->params;
+    *buffer_size = params->block_size;
+    size_t blocks = file_size > 0 ? (file_size + params->block_size - 1) / params->block_size : 1;
+    int pooled_threads = pin_policy == PIN_NONE;   // pinned threads allocate their own
+    if (method->run == sequential_read || method->run == random_read ||
+        method->run == alternating_read || method->run == memory_copy) {
+        return 1;
+    }
+    if (method->run == async_sequential_read) {
+        int readers = auto_tune ? MAX_READERS : params->readers;
+        int consumers = auto_tune ? MAX_CONSUMERS : params->consumers;
+        // Slice-sized copies, queued plus one being hashed per consumer; a
+        // byte budget keeps fewer in flight besides the staging buffers
+        size_t slice = async_slice_size(params, readers);
+        if (slice == 0) {
+            return 0;
+        }
+        *buffer_size = slice;
+        int copies = MAX_QUEUE_SIZE + consumers;
+        if (max_inflight_bytes > 0 && max_inflight_bytes / slice - readers < (size_t)copies) {
+            copies = (int)(max_inflight_bytes / slice) - readers;
+        }
+        copies = min_blocks(copies, blocks * ((params->block_size + slice - 1) / slice));
+        return (pooled_threads ? min_blocks(readers, blocks) : 0) + copies;
+    }
+    if (method->run == work_stealing_read) {
+        return pooled_threads ? min_blocks(params->workers, blocks) : 0;
+    }
+    if (method->run == ordered_async_read) {
+        return min_blocks(params->window, blocks);
+    }
+    if (method->run == event_loop_read) {
+        return min_blocks(params->queue_depth, blocks);
+    }
+    return 0;   // mmap methods, the in-memory hash and iops use no session buffers
+}
+
+static int parse_schedule_order(const char *name, ScheduleOrder *order) {
+    if (strcmp(name, "fixed") == 0) {
+        *order = ORDER_FIXED;
+    } else if (strcmp(name, "shuffle") == 0) {
+        *order = ORDER_SHUFFLE;
+    } else if (strcmp(name, "interleave") == 0) {
+        *order = ORDER_INTERLEAVE;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+static const char *schedule_order_name(ScheduleOrder order) {
+    switch (order) {
+    case ORDER_SHUFFLE:    return "shuffle";
+    case ORDER_INTERLEAVE: return "interleave";
+    default:               return "fixed";
+    }
+}
+
+// Block latencies of every timed run of each selection (--latency),
+// PHASE_COUNT histograms per selection
+static LatencyHistogram *selection_latency = NULL;
+
+// Evict the file ahead of a run (--cold); warns once if eviction fails
+static void evict_file(String filename) {
+    static int warned = 0;
+    int dropped_all = 0;
+    int ok = page_cache_evict(filename, drop_caches, &dropped_all);
+    if (!warned && (!ok || (drop_caches && !dropped_all))) {
+        if (!ok) {
+            fprintf(stderr, "Warning: Cannot evict %s from the page cache\n", filename);
+        } else {
+            fprintf(stderr, "Warning: Cannot write /proc/sys/vm/drop_caches (needs root), "
+                   "using posix_fadvise only\n");
+        }
+        warned = 1;
+    }
+}
+
+// GB/s of every selection at its median run (0 where no run succeeded)
+static double *median_gbps(const MethodResult *results) {
+    double *samples = malloc(repeat_count * sizeof(double));
+    double *gbps = calloc(num_selections, sizeof(double));
+    if (!samples || !gbps) {
+        free(samples);
+        free(gbps);
+        return NULL;
+    }
+    for (int m = 0; m < num_selections; m++) {
+        int count = 0;
+        size_t bytes = 0;
+        for (int r = 0; r < repeat_count; r++) {
+            const MethodResult *result = &results[m * repeat_count + r];
+            if (result->ok) {
+                samples[count++] = result->seconds;
+                bytes = result->total_bytes;
+            }
+        }
+        SampleStats stats;
+        if (stats_compute(samples, count, &stats) && stats.median > 0) {
+            gbps[m] = bytes / stats.median / 1e9;
+        }
+    }
+    free(samples);
+    return gbps;
+}
+
+// Throughput at the median run for each method and block size (--sweep):
+// one column per swept method, then its peak and knee
+static void print_sweep_table(const MethodResult *results) {
+    int num_bases = num_selections / num_sweep_sizes;
+    double *gbps = median_gbps(results);
+    if (!gbps) {
+        return;
+    }
+    
+    printf("\nBlock-size sweep (GB/s at the median run):\n%-8s", "Block");
+    for (int b = 0; b < num_bases; b++) {
+        const char *key = selections[b * num_sweep_sizes].method->key;
+        // Repeated keys (same method, other overrides) get their position appended
+        int repeats = 0;
+        for (int other = 0; other < b; other++) {
+            repeats += strcmp(selections[other * num_sweep_sizes].method->key, key) == 0;
+        }
+        char header[16];
+        if (repeats > 0) {
+            snprintf(header, sizeof(header), "%s#%d", key, repeats + 1);
+        } else {
+            snprintf(header, sizeof(header), "%s", key);
+        }
+        printf(" %9s", header);
+    }
+    printf("\n");
+    for (int k = 0; k < num_sweep_sizes; k++) {
+        char size_text[24];
+        format_size(sweep_sizes[k], size_text, sizeof(size_text));
+        printf("%-8s", size_text);
+        for (int b = 0; b < num_bases; b++) {
+            double value = gbps[b * num_sweep_sizes + k];
+            if (value > 0) {
+                printf(" %9.3f", value);
+            } else {
+                printf(" %9s", "-");
+            }
+        }
+        printf("\n");
+    }
+    
+    printf("\n");
+    for (int b = 0; b < num_bases; b++) {
+        const double *row = &gbps[b * num_sweep_sizes];
+        int peak = 0;
+        for (int k = 1; k < num_sweep_sizes; k++) {
+            peak = row[k] > row[peak] ? k : peak;
+        }
+        int knee = peak;
+        for (int k = 0; k < num_sweep_sizes; k++) {
+            if (row[k] >= SWEEP_KNEE * row[peak]) {
+                knee = k;
+                break;
+            }
+        }
+        char peak_text[24], knee_text[24];
+        format_size(sweep_sizes[peak], peak_text, sizeof(peak_text));
+        format_size(sweep_sizes[knee], knee_text, sizeof(knee_text));
+        printf("%s: peak %.3f GB/s at %s, %.0f%% of peak from %s\n", sweep_labels[b],
+               row[peak], peak_text, 100.0 * SWEEP_KNEE, knee_text);
+    }
+    free(gbps);
+}
+
+// GB/s of the fastest baseline of one kind at selection m's block size (0 if none ran)
+static double fastest_ceiling(const double *gbps, int m, Ceiling ceiling) {
+    double fastest = 0.0;
+    for (int b = 0; b < num_selections; b++) {
+        if (selections[b].method->ceiling == ceiling &&
+            selections[b].params.block_size == selections[m].params.block_size &&
+            gbps[b] > fastest) {
+            fastest = gbps[b];
+        }
+    }
+    return fastest;
+}
+
+// Each method's throughput as a share of the in-memory ceilings measured at
+// the same block size: near the hash ceiling it is CPU-bound, near memcpy
+// memory-bound, and well below both it waits on I/O
+static void print_ceiling_table(const MethodResult *results) {
+    double *gbps = median_gbps(results);
+    if (!gbps) {
+        return;
+    }
+    int have_ceiling = 0, have_method = 0;
+    int width = 22;
+    for (int m = 0; m < num_selections; m++) {
+        int len = (int)strlen(selections[m].label);
+        width = len > width ? len : width;
+        if (selections[m].method->ceiling != CEILING_NONE) {
+            have_ceiling |= gbps[m] > 0;
+        } else {
+            have_method |= gbps[m] > 0;
+        }
+    }
+    if (!have_ceiling || !have_method) {
+        free(gbps);
+        return;
+    }
+    
+    printf("\nIn-memory ceilings (GB/s at the median run):\n");
+    for (int m = 0; m < num_selections; m++) {
+        if (selections[m].method->ceiling != CEILING_NONE && gbps[m] > 0) {
+            printf("  %-*s %9.3f\n", width, selections[m].label, gbps[m]);
+        }
+    }
+    printf("%-*s %9s %9s %9s\n", width + 2, "Method", "GB/s", "% hash", "% memcpy");
+    for (int m = 0; m < num_selections; m++) {
+        if (selections[m].method->ceiling != CEILING_NONE) {
+            continue;
+        }
+        printf("  %-*s", width, selections[m].label);
+        if (gbps[m] <= 0) {
+            printf(" %9s\n", "skipped");
+            continue;
+        }
+        printf(" %9.3f", gbps[m]);
+        for (int c = CEILING_HASH; c < CEILING_COUNT; c++) {
+            double ceiling = fastest_ceiling(gbps, m, (Ceiling)c);
+            if (ceiling > 0) {
+                printf(" %8.1f%%", 100.0 * gbps[m] / ceiling);
+            } else {
+                printf(" %9s", "-");
+            }
+        }
+        printf("\n");
+    }
+    free(gbps);
+}
+
+// JSON string literal with the required escapes
+static void print_json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char*)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(out, "\\%c", *p);
+        } else if (*p < 0x20) {
+            fprintf(out, "\\u%04x", *p);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// CSV field, quoted (with doubled quotes) only when it needs to be
+static void print_csv_string(FILE *out, const char *text) {
+    if (strpbrk(text, ",\"\n\r") == NULL) {
+        fputs(text, out);
+        return;
+    }
+    fputc('"', out);
+    for (const char *p = text; *p; p++) {
+        if (*p == '"') {
+            fputc('"', out);
+        }
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+// Sampler thread state for one run
+struct Sampler {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    int stop;
+    BenchSession *session;
+    const MethodSelection *selection;
+    int run;              // index among the selection's timed (or warmup) runs
+    int warmup;
+    size_t file_size;
+    struct timespec start;
+    int samples;          // intervals measured
+    double min_gbps;      // slowest and fastest interval
+    double max_gbps;
+};
+
+static void sampler_take(Sampler *sampler, double *last_seconds, size_t *last_bytes) {
+    double seconds = timer_elapsed(sampler->start);
+    size_t bytes = __atomic_load_n(&progress_bytes, __ATOMIC_RELAXED);
+    int depth = __atomic_load_n(&progress_depth, __ATOMIC_RELAXED);
+    int threads = thread_pool_busy(&sampler->session->pool) + 1;  // plus the method's own
+    double dt = seconds - *last_seconds;
+    double gbps = dt > 0 ? (bytes - *last_bytes) / dt / 1e9 : 0.0;
+    *last_seconds = seconds;
+    *last_bytes = bytes;
+    
+    if (sampler->samples == 0 || gbps < sampler->min_gbps) {
+        sampler->min_gbps = gbps;
+    }
+    if (sampler->samples == 0 || gbps > sampler->max_gbps) {
+        sampler->max_gbps = gbps;
+    }
+    sampler->samples++;
+    
+    if (timeseries_file) {
+        print_csv_string(timeseries_file, sampler->selection->label);
+        fprintf(timeseries_file, ",%s,%d,%d,%.6f,%zu,%.6f,", sampler->selection->method->key,
+                sampler->warmup, sampler->run, seconds, bytes, gbps);
+        if (depth >= 0) {
+            fprintf(timeseries_file, "%d", depth);
+        }
+        fprintf(timeseries_file, ",%d\n", threads);
+    }
+    if (show_progress) {
+        fprintf(stderr, "\r\033[K%s%s: %5.1f%%  %7.3f GB/s", sampler->selection->label,
+                sampler->warmup ? " (warmup)" : "",
+                sampler->file_size > 0 ? 100.0 * bytes / sampler->file_size : 0.0, gbps);
+        if (depth >= 0) {
+            fprintf(stderr, "  depth %d", depth);
+        }
+        fprintf(stderr, "  threads %d", threads);
+        fflush(stderr);
+    }
+}
+
+static void *sampler_thread(void *arg) {
+    Sampler *sampler = (Sampler*)arg;
+    double last_seconds = 0.0;
+    size_t last_bytes = 0;
+    struct timespec deadline = sampler->start;
+    
+    pthread_mutex_lock(&sampler->mutex);
+    while (!sampler->stop) {
+        deadline.tv_nsec += (long)sample_ms * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        while (!sampler->stop &&
+               pthread_cond_timedwait(&sampler->wake, &sampler->mutex, &deadline) != ETIMEDOUT) {
+        }
+        if (sampler->stop) {
+            break;
+        }
+        pthread_mutex_unlock(&sampler->mutex);
+        sampler_take(sampler, &last_seconds, &last_bytes);
+        pthread_mutex_lock(&sampler->mutex);
+    }
+    pthread_mutex_unlock(&sampler->mutex);
+    if (show_progress) {
+        fprintf(stderr, "\r\033[K");
+        fflush(stderr);
+    }
+    return NULL;
+}
+
+// Start sampling a run (outside its timed region); 0 if no thread could start
+static int sampler_start(Sampler *sampler, BenchSession *session, const MethodSelection *selection,
+                         String filename, int warmup) {
+    static int timed_runs[MAX_SELECTED];
+    static int warmup_runs[MAX_SELECTED];
+    int index = (int)(selection - selections);
+    memset(sampler, 0, sizeof(*sampler));
+    sampler->session = session;
+    sampler->selection = selection;
+    sampler->warmup = warmup;
+    sampler->run = warmup ? warmup_runs[index]++ : timed_runs[index]++;
+    struct stat st;
+    if (stat(filename, &st) == 0) {
+        sampler->file_size = st.st_size;
+    }
+    
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sampler->wake, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    pthread_mutex_init(&sampler->mutex, NULL);
+    
+    __atomic_store_n(&progress_bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&progress_depth, -1, __ATOMIC_RELAXED);
+    sampling = 1;
+    clock_gettime(CLOCK_MONOTONIC, &sampler->start);
+    if (pthread_create(&sampler->thread, NULL, sampler_thread, sampler) != 0) {
+        sampling = 0;
+        pthread_mutex_destroy(&sampler->mutex);
+        pthread_cond_destroy(&sampler->wake);
+        return 0;
+    }
+    return 1;
+}
+
+static void sampler_stop(Sampler *sampler) {
+    active_sampler = NULL;
+    pthread_mutex_lock(&sampler->mutex);
+    sampler->stop = 1;
+    pthread_cond_signal(&sampler->wake);
+    pthread_mutex_unlock(&sampler->mutex);
+    pthread_join(sampler->thread, NULL);
+    sampling = 0;
+    pthread_mutex_destroy(&sampler->mutex);
+    pthread_cond_destroy(&sampler->wake);
+}
+
+// Run one method once; quiet runs print nothing
+static void run_method(BenchSession *session, const MethodSelection *selection, String filename,
+                       MethodResult *result, int quiet, int warmup) {
+    const BenchMethod *method = selection->method;
+    const MethodParams *params = &selection->params;
+    if (cold_cache) {
+        evict_file(filename);
+    }
+    // Residency is sampled outside the timed region
+    size_t resident_bytes = 0;
+    size_t file_bytes = 0;
+    double resident_fraction = 0.0;
+    if (page_cache_residency(filename, &resident_bytes, &file_bytes) && file_bytes > 0) {
+        resident_fraction = (double)resident_bytes / file_bytes;
+    }
+    
+    // The pool holds (and has faulted in) what this method takes, before
+    // timing; only the part a block of this file can fill is touched
+    struct stat file_stat;
+    size_t file_size = stat(filename, &file_stat) == 0 ? (size_t)file_stat.st_size : 0;
+    size_t buffer_size;
+    int buffer_count = method_buffers(selection, file_size, &buffer_size);
+    size_t prefault_bytes = file_size > 0 && file_size < buffer_size ? file_size : buffer_size;
+    buffer_pool_reserve(&session->buffers, buffer_size, prefault_bytes, buffer_count);
+    
+    int saved_verbosity = verbosity;
+    if (quiet) {
+        verbosity = -1;
+    }
+    memset(result, 0, sizeof(*result));
+    // Thread shape: workers both read and hash, pipelines split the roles
+    result->block_size = params->block_size;
+    result->readers = (method->params & PARAM_READERS) ? params->readers :
+                      (method->params & PARAM_WORKERS) ? params->workers : 1;
+    result->consumers = (method->params & PARAM_CONSUMERS) ? params->consumers :
+                        (method->params & PARAM_WORKERS) ? params->workers : 1;
+    result->threads = (method->params & PARAM_READERS) ? result->readers + result->consumers :
+                      result->readers;
+    
+    // Counters attach to existing threads, so start the method's workers first
+    if (perf_enabled) {
+        int needed = result->threads;
+        if (auto_tune && (method->params & PARAM_CONSUMERS)) {
+            needed = MAX_READERS + MAX_CONSUMERS;
+        }
+        thread_pool_reserve(&session->pool, needed);
+        perf_active = perf_counters_open(&perf_counters) > 0;
+        static int warned = 0;
+        if (!perf_active && !warned) {
+            fprintf(stderr, "Warning: perf counters unavailable (%s); "
+                    "check /proc/sys/kernel/perf_event_paranoid\n",
+                    strerror(perf_counters.open_errno));
+            warned = 1;
+        }
+    }
+    // Started after the counters open, so the sampler itself is not counted
+    Sampler sampler;
+    int sampled = (timeseries_file || show_progress) &&
+                  sampler_start(&sampler, session, selection, filename, warmup);
+    if (sampled) {
+        active_sampler = &sampler;
+    }
+    uint64_t run_start = span_begin();
+    method->run(session, filename, params, result);
+    if (active_sampler) {
+        sampler_stop(active_sampler);   // the method failed before timing ended
+    }
+    if (tracing) {
+        trace_span(selection->label, warmup ? "warmup" : "run", run_start, now_ns());
+    }
+    if (perf_active) {
+        perf_counters_close(&perf_counters);
+        perf_active = 0;
+    }
+    result->resident_fraction = resident_fraction;
+    result->cache = resident_fraction < COLD_RESIDENCY ? CACHE_COLD :
+                    resident_fraction > WARM_RESIDENCY ? CACHE_WARM : CACHE_PARTIAL;
+    if (result->ok && verbosity >= 1) {
+        printf("  Page cache: %s (%.1f%% resident at start)\n",
+               cache_state_names[result->cache], 100.0 * resident_fraction);
+    }
+    if (sampled && sampler.samples > 0 && result->ok && verbosity >= 1) {
+        printf("  Throughput over %d samples of %d ms: min %.3f GB/s, max %.3f GB/s\n",
+               sampler.samples, sample_ms, sampler.min_gbps, sampler.max_gbps);
+    }
+    if (latency_enabled) {
+        // Drain the threads' histograms after every run so warmups leave nothing behind
+        static LatencyHistogram run_latency[PHASE_COUNT];
+        phase_collect(run_latency);
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            phase_summarize(&run_latency[p], &result->latency[p]);
+            if (!warmup && result->ok) {
+                latency_histogram_merge(&selection_latency[(selection - selections) * PHASE_COUNT + p],
+                                        &run_latency[p]);
+            }
+        }
+        if (result->ok && verbosity >= 1) {
+            printf("  Block latency:\n");
+            print_phase_latency("    ", "", result->latency);
+        }
+    }
+    verbosity = saved_verbosity;
+}
+
+typedef enum {
+    USAGE_MINOR_FAULTS,
+    USAGE_MAJOR_FAULTS,
+    USAGE_VOLUNTARY_SWITCHES,
+    USAGE_INVOLUNTARY_SWITCHES,
+    USAGE_DEVICE_MB,
+    USAGE_READ_MB,
+    USAGE_READ_CALLS,
+    USAGE_NUM_COLUMNS
+} UsageColumn;
+
+static const char *usage_column_names[USAGE_NUM_COLUMNS] = {
+    "minflt", "majflt", "vcsw", "ivcsw", "device MB", "read() MB", "syscr"
+};
+
+// Value of one summary column, or -1 when /proc/self/io was unavailable
+static double usage_value(const ResourceUsage *usage, UsageColumn column) {
+    switch (column) {
+    case USAGE_MINOR_FAULTS:         return usage->minor_faults;
+    case USAGE_MAJOR_FAULTS:         return usage->major_faults;
+    case USAGE_VOLUNTARY_SWITCHES:   return usage->voluntary_switches;
+    case USAGE_INVOLUNTARY_SWITCHES: return usage->involuntary_switches;
+    case USAGE_DEVICE_MB:            return usage->have_io ? usage->read_bytes / 1e6 : -1.0;
+    case USAGE_READ_MB:              return usage->have_io ? usage->rchar / 1e6 : -1.0;
+    case USAGE_READ_CALLS:           return usage->have_io ? (double)usage->syscr : -1.0;
+    default:                         return -1.0;
+    }
+}
+
+// Median OS resource deltas per run for each method
+static void print_usage_summary(const MethodResult *results, int width) {
+    double *samples = malloc(repeat_count * sizeof(double));
+    if (!samples) {
+        return;
+    }
+    printf("\nOS resources per run (median):\n%-*s", width, "Method");
+    for (int c = 0; c < USAGE_NUM_COLUMNS; c++) {
+        printf(" %10s", usage_column_names[c]);
+    }
+    printf("\n");
+    for (int m = 0; m < num_selections; m++) {
+        const MethodResult *runs = &results[m * repeat_count];
+        printf("%-*s", width, selections[m].label);
+        for (int c = 0; c < USAGE_NUM_COLUMNS; c++) {
+            int count = 0;
+            for (int r = 0; r < repeat_count; r++) {
+                double value = usage_value(&runs[r].usage, (UsageColumn)c);
+                if (runs[r].ok && value >= 0) {
+                    samples[count++] = value;
+                }
+            }
+            SampleStats stats;
+            if (!stats_compute(samples, count, &stats)) {
+                printf(" %10s", "n/a");
+            } else if (c == USAGE_DEVICE_MB || c == USAGE_READ_MB) {
+                printf(" %10.1f", stats.median);
+            } else {
+                printf(" %10.0f", stats.median);
+            }
+        }
+        printf("\n");
+    }
+    free(samples);
+}
+
+// Block latencies pooled over all timed runs of each method (--latency)
+static void print_latency_summary(void) {
+    printf("\nBlock latency over all timed runs (microseconds):\n");
+    for (int m = 0; m < num_selections; m++) {
+        PhaseLatency latency[PHASE_COUNT];
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            phase_summarize(&selection_latency[m * PHASE_COUNT + p], &latency[p]);
+        }
+        printf("%s\n", selections[m].label);
+        print_phase_latency("  ", "", latency);
+    }
+}
+
+// Median counter values per byte for each method (--perf)
+static void print_perf_summary(const MethodResult *results, int width) {
+    double *samples = malloc(repeat_count * sizeof(double));
+    if (!samples) {
+        return;
+    }
+    printf("\nCounters per byte (median):\n%-*s", width, "Method");
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        printf(" %16s", perf_event_name((PerfEvent)e));
+    }
+    printf("\n");
+    for (int m = 0; m < num_selections; m++) {
+        const MethodResult *runs = &results[m * repeat_count];
+        printf("%-*s", width, selections[m].label);
+        for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+            int count = 0;
+            for (int r = 0; r < repeat_count; r++) {
+                if (runs[r].ok && (runs[r].perf_available & (1u << e))) {
+                    samples[count++] = result_perf_per_byte(&runs[r], e);
+                }
+            }
+            SampleStats stats;
+            if (stats_compute(samples, count, &stats)) {
+                printf(" %16.4g", stats.median);
+            } else {
+                printf(" %16s", "n/a");
+            }
+        }
+        printf("\n");
+    }
+    free(samples);
+}
+
+// Summary statistics over the timed runs of each method
+// (results holds repeat_count runs per method, method-major)
+static void print_summary(const MethodResult *results) {
+    double *samples = malloc(repeat_count * sizeof(double));
+    double *cpu_samples = malloc(repeat_count * sizeof(double));
+    if (!samples || !cpu_samples) {
+        free(samples);
+        free(cpu_samples);
+        return;
+    }
+    printf("\nSummary (%d runs, %d warmup, order %s", repeat_count, warmup_count,
+           schedule_order_name(schedule_order));
+    if (schedule_order == ORDER_SHUFFLE) {
+        printf(", seed %llu", (unsigned long long)schedule_seed);
+    }
+    printf(", seconds):\n");
+    int width = 22;
+    for (int m = 0; m < num_selections; m++) {
+        int len = (int)strlen(selections[m].label);
+        width = len > width ? len : width;
+    }
+    printf("%-*s %10s %10s %10s %10s %10s %9s %9s %7s %6s\n", width,
+           "Method", "min", "median", "mean", "stddev", "p95", "GB/s", "CPU-s/GB", "cyc/B", "cache");
+    for (int m = 0; m < num_selections; m++) {
+        int count = 0;
+        int hash_mismatch = 0;
+        int cache_runs[CACHE_STATE_COUNT] = {0};
+        size_t total_bytes = 0;
+        const MethodResult *runs = &results[m * repeat_count];
+        const MethodResult *first = NULL;
+        for (int r = 0; r < repeat_count; r++) {
+            if (!runs[r].ok) {
+                continue;
+            }
+            if (!first) {
+                first = &runs[r];
+            } else if (runs[r].hash != first->hash) {
+                hash_mismatch = 1;
+            }
+            total_bytes = runs[r].total_bytes;
+            cache_runs[runs[r].cache]++;
+            cpu_samples[count] = result_cpu_per_gb(&runs[r]);
+            samples[count++] = runs[r].seconds;
+        }
+        SampleStats stats;
+        if (!stats_compute(samples, count, &stats)) {
+            printf("%-*s %10s\n", width, selections[m].label, "skipped");
+            continue;
+        }
+        // CPU cost at the median run
+        SampleStats cpu_stats;
+        stats_compute(cpu_samples, count, &cpu_stats);
+        // One state when every run shared it
+        const char *cache = "mixed";
+        for (int c = 0; c < CACHE_STATE_COUNT; c++) {
+            if (cache_runs[c] == count) {
+                cache = cache_state_names[c];
+            }
+        }
+        printf("%-*s %10.6f %10.6f %10.6f %10.6f %10.6f %9.3f %9.3f %7.2f %6s\n",
+               width, selections[m].label, stats.min, stats.median, stats.mean, stats.stddev, stats.p95,
+               stats.median > 0 ? total_bytes / stats.median / 1e9 : 0.0,
+               cpu_stats.median, cpu_stats.median * cpu_hz / 1e9,
+               cache);
+        if (verbosity >= 1 && !first->unhashed) {
+            printf("  Hash (XOR): %016llx%s\n", (unsigned long long)first->hash,
+                   hash_mismatch ? " (differs between runs!)" : "");
+        }
+        if (first->ops > 0) {
+            printf("  IOPS at the median run: %.0f\n", stats.median > 0 ? first->ops / stats.median : 0.0);
+        }
+        if (print_samples) {
+            printf("  Samples:");
+            for (int i = 0; i < count; i++) {
+                printf(" %f", samples[i]);
+            }
+            printf("\n");
+        }
+    }
+    free(samples);
+    free(cpu_samples);
+    if (verbosity >= 1) {
+        print_usage_summary(results, width);
+    }
+    if (perf_enabled) {
+        print_perf_summary(results, width);
+    }
+    if (latency_enabled) {
+        print_latency_summary();
+    }
+}
+
+// Single-thread hash rate (GB/s) over one warm block, for verdicts at a
+// block size no memhash run measured
+static double calibrate_hash_rate(size_t block_size) {
+    size_t size = block_size < CALIBRATE_MAX_BYTES ? block_size : CALIBRATE_MAX_BYTES;
+    unsigned char *buffer = malloc(size);
+    if (!buffer) {
+        return 0.0;
+    }
+    memset(buffer, 0xA5, size);
+    setup_hashing();
+    volatile uint64_t sink = 0;
+    size_t bytes = 0;
+    double seconds;
+    struct timespec start = timer_start();
+    do {
+        sink ^= crc64_compute(buffer, size);
+        bytes += size;
+        seconds = timer_elapsed(start);
+    } while (seconds < CALIBRATE_SECONDS);
+    (void)sink;
+    free(buffer);
+    return bytes / seconds / 1e9;
+}
+
+typedef enum {
+    BOUND_HASH,
+    BOUND_FAULT,
+    BOUND_COPY,
+    BOUND_IO,
+    BOUND_SYNC,
+    BOUND_COUNT
+} Bound;
+
+static const char *bound_names[BOUND_COUNT] = {"hash-bound", "fault-bound", "copy-bound", "I/O-bound",
+                                               "sync-bound"};
+
+static int method_maps_file(const BenchMethod *method) {
+    return method->run == sequential_mmap || method->run == random_mmap ||
+           method->run == alternating_mmap;
+}
+
+// Split each method's thread time (threads x wall, over all timed runs) into
+// hashing at the compute ceiling, other CPU work, and time off the CPU.
+// Other CPU is page-fault handling for the mmap methods. For the rest it is
+// the read path: device I/O for the share of bytes that came from the
+// device, copying out of the page cache for the others. Time off the CPU
+// waits on the device when most bytes came from it, and on queues and locks
+// when they did not.
+static void print_bottleneck_table(const MethodResult *results) {
+    double *gbps = median_gbps(results);
+    if (!gbps) {
+        return;
+    }
+    size_t calibrated_sizes[MAX_SELECTED];
+    double calibrated_rates[MAX_SELECTED];
+    int num_calibrated = 0;
+    int width = 22;
+    for (int m = 0; m < num_selections; m++) {
+        int len = (int)strlen(selections[m].label);
+        width = len > width ? len : width;
+    }
+    
+    printf("\nBottleneck (share of thread time over the timed runs):\n");
+    printf("%-*s %-11s %6s %6s %6s %6s %6s %6s %7s %9s %9s\n", width, "Method", "Verdict",
+           "hash", "fault", "copy", "I/O", "sync", "cores", "device", "faults/MB", "hash GB/s");
+    for (int m = 0; m < num_selections; m++) {
+        if (selections[m].method->ceiling != CEILING_NONE) {
+            continue;
+        }
+        const MethodResult *runs = &results[m * repeat_count];
+        int count = 0, have_io = 1, threads = 1;
+        double wall = 0.0, cpu = 0.0, bytes = 0.0, device = 0.0, faults = 0.0;
+        double uncached = 0.0;   // bytes not resident when their run started
+        for (int r = 0; r < repeat_count; r++) {
+            if (!runs[r].ok) {
+                continue;
+            }
+            count++;
+            wall += runs[r].seconds;
+            cpu += runs[r].cpu_seconds;
+            bytes += runs[r].total_bytes;
+            device += runs[r].usage.read_bytes;
+            faults += runs[r].usage.minor_faults + runs[r].usage.major_faults;
+            uncached += (1.0 - runs[r].resident_fraction) * runs[r].total_bytes;
+            have_io &= runs[r].usage.have_io;
+            threads = runs[r].threads;
+        }
+        if (count == 0 || wall <= 0) {
+            printf("%-*s %-11s\n", width, selections[m].label, "skipped");
+            continue;
+        }
+        
+        double hash_rate = fastest_ceiling(gbps, m, CEILING_HASH);
+        size_t block_size = selections[m].params.block_size;
+        for (int c = 0; c < num_calibrated && hash_rate <= 0; c++) {
+            if (calibrated_sizes[c] == block_size) {
+                hash_rate = calibrated_rates[c];
+            }
+        }
+        if (hash_rate <= 0) {
+            hash_rate = calibrate_hash_rate(block_size);
+            calibrated_sizes[num_calibrated] = block_size;
+            calibrated_rates[num_calibrated++] = hash_rate;
+        }
+        
+        if (host_info.num_cpus > 0 && threads > host_info.num_cpus) {
+            threads = host_info.num_cpus;
+        }
+        double hash_time = hash_rate > 0 ? bytes / (hash_rate * 1e9) : 0.0;
+        hash_time = hash_time < cpu ? hash_time : cpu;
+        double other_cpu = cpu - hash_time;
+        double off_cpu = threads * wall > cpu ? threads * wall - cpu : 0.0;
+        if (!have_io) {
+            device = uncached;
+        }
+        double device_share = device < bytes ? device / bytes : 1.0;
+        int from_device = device >= DEVICE_BOUND_SHARE * bytes;
+        
+        double share[BOUND_COUNT] = {0};
+        share[BOUND_HASH] = hash_time;
+        if (method_maps_file(selections[m].method)) {
+            share[BOUND_FAULT] += other_cpu;
+        } else {
+            share[BOUND_IO] += other_cpu * device_share;
+            share[BOUND_COPY] += other_cpu * (1.0 - device_share);
+        }
+        share[from_device ? BOUND_IO : BOUND_SYNC] += off_cpu;
+        double total = hash_time + other_cpu + off_cpu;
+        Bound verdict = BOUND_HASH;
+        for (int b = 1; b < BOUND_COUNT; b++) {
+            verdict = share[b] > share[verdict] ? (Bound)b : verdict;
+        }
+        
+        char device_text[16];
+        if (have_io) {
+            snprintf(device_text, sizeof(device_text), "%.0f%%", 100.0 * device / bytes);
+        } else {
+            snprintf(device_text, sizeof(device_text), "n/a");
+        }
+        printf("%-*s %-11s", width, selections[m].label, bound_names[verdict]);
+        for (int b = 0; b < BOUND_COUNT; b++) {
+            printf(" %5.0f%%", total > 0 ? 100.0 * share[b] / total : 0.0);
+        }
+        printf(" %6.2f %7s %9.1f %9.3f\n", cpu / wall, device_text, faults / (bytes / 1e6), hash_rate);
+    }
+    free(gbps);
+}
+
+static const char *output_format_name(OutputFormat format) {
+    switch (format) {
+    case FORMAT_JSON: return "json";
+    case FORMAT_CSV:  return "csv";
+    default:          return "text";
+    }
+}
+
+static double result_iops(const MethodResult *result) {
+    return result->seconds > 0 ? result->ops / result->seconds : 0.0;
+}
+
+// Whether the run list has a random IOPS method, whose CSV columns are added
+static int iops_selected(void) {
+    for (int m = 0; m < num_selections; m++) {
+        if (selections[m].method->params & PARAM_OPS) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static double result_gbps(const MethodResult *result) {
+    return result->seconds > 0 ? result->total_bytes / result->seconds / 1e9 : 0.0;
+}
+
+// One JSON document: host and configuration metadata plus every timed run
+static void write_results_json(FILE *out, const MethodResult *results, String filename,
+                               const HostInfo *host) {
+    fprintf(out, "{\n  \"host\": {\n    \"hostname\": ");
+    print_json_string(out, host->hostname);
+    fprintf(out, ",\n    \"cpu_model\": ");
+    print_json_string(out, host->cpu_model);
+    fprintf(out, ",\n    \"cpu_mhz\": %.1f,\n    \"cpus\": %d,\n    \"numa_nodes\": %d,\n    \"kernel\": ",
+            host->cpu_mhz, host->num_cpus, topology.num_nodes > 0 ? topology.num_nodes : 1);
+    print_json_string(out, host->kernel);
+    fprintf(out, ",\n    \"filesystem\": ");
+    print_json_string(out, host->fs_type);
+    fprintf(out, ",\n    \"device\": ");
+    print_json_string(out, host->fs_device);
+    fprintf(out, ",\n    \"mount_point\": ");
+    print_json_string(out, host->mount_point);
+    
+    fprintf(out, "\n  },\n  \"config\": {\n    \"file\": ");
+    print_json_string(out, filename);
+    // Only a block size every selection shares; the records carry their own
+    size_t block_size = num_selections > 0 ? selections[0].params.block_size : 0;
+    for (int m = 1; m < num_selections; m++) {
+        if (selections[m].params.block_size != block_size) {
+            block_size = 0;
+        }
+    }
+    if (block_size > 0) {
+        fprintf(out, ",\n    \"block_size\": %zu", block_size);
+    }
+    fprintf(out, ",\n    \"chunk_size\": %zu,\n"
+            "    \"max_inflight_bytes\": %zu,\n    \"pin\": \"%s\",\n    \"auto_tune\": %s,\n"
+            "    \"repeat\": %d,\n    \"warmup\": %d,\n    \"order\": \"%s\",\n"
+            "    \"seed\": %llu,\n    \"access_seed\": %llu,\n    \"cold\": %s,\n    \"drop_caches\": %s\n  },\n",
+            chunk_size, max_inflight_bytes, topology_policy_name(pin_policy),
+            auto_tune ? "true" : "false", repeat_count, warmup_count,
+            schedule_order_name(schedule_order), (unsigned long long)schedule_seed,
+            (unsigned long long)access_seed, cold_cache ? "true" : "false", drop_caches ? "true" : "false");
+    
+    fprintf(out, "  \"results\": [");
+    int first = 1;
+    for (int m = 0; m < num_selections; m++) {
+        for (int r = 0; r < repeat_count; r++) {
+            const MethodResult *result = &results[m * repeat_count + r];
+            if (!result->ok) {
+                continue;
+            }
+            fprintf(out, "%s\n    {\"method\": ", first ? "" : ",");
+            print_json_string(out, selections[m].method->name);
+            fprintf(out, ", \"key\": \"%s\", \"label\": ", selections[m].method->key);
+            print_json_string(out, selections[m].label);
+            fprintf(out, ", \"run\": %d", r);
+            if (!result->unhashed) {
+                fprintf(out, ", \"hash\": \"%016llx\"", (unsigned long long)result->hash);
+            }
+            fprintf(out, ", \"bytes\": %zu, "
+                    "\"seconds\": %.9f, \"gbps\": %.6f, \"block_size\": %zu, "
+                    "\"threads\": %d, \"readers\": %d, \"consumers\": %d, "
+                    "\"cache\": \"%s\", \"resident_fraction\": %.4f, "
+                    "\"cpu_seconds\": %.6f, \"main_cpu_seconds\": %.6f, \"worker_cpu_seconds\": %.6f, "
+                    "\"cpu_seconds_per_gb\": %.6f, \"cycles_per_byte\": %.4f",
+                    result->total_bytes,
+                    result->seconds, result_gbps(result), result->block_size,
+                    result->threads, result->readers, result->consumers,
+                    cache_state_names[result->cache], result->resident_fraction,
+                    result->cpu_seconds, result->main_cpu_seconds, result->worker_cpu_seconds,
+                    result_cpu_per_gb(result), result_cycles_per_byte(result));
+            const ResourceUsage *usage = &result->usage;
+            fprintf(out, ", \"minor_faults\": %ld, \"major_faults\": %ld, "
+                    "\"voluntary_switches\": %ld, \"involuntary_switches\": %ld",
+                    usage->minor_faults, usage->major_faults,
+                    usage->voluntary_switches, usage->involuntary_switches);
+            if (usage->have_io) {
+                fprintf(out, ", \"read_bytes\": %llu, \"rchar\": %llu, \"syscr\": %llu",
+                        (unsigned long long)usage->read_bytes, (unsigned long long)usage->rchar,
+                        (unsigned long long)usage->syscr);
+            } else {
+                fprintf(out, ", \"read_bytes\": null, \"rchar\": null, \"syscr\": null");
+            }
+            if (perf_enabled) {
+                fprintf(out, ", \"counters\": {");
+                for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+                    fprintf(out, "%s\"%s\": ", e ? ", " : "", perf_event_name((PerfEvent)e));
+                    if (result->perf_available & (1u << e)) {
+                        fprintf(out, "%llu", (unsigned long long)result->perf_values[e]);
+                    } else {
+                        fprintf(out, "null");
+                    }
+                }
+                fprintf(out, "}");
+            }
+            if (result->ops > 0) {
+                const PhaseLatency *l = &result->op_latency;
+                fprintf(out, ", \"ops\": %zu, \"iops\": %.1f, \"op_latency_ns\": {\"mean\": %.1f, "
+                        "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+                        result->ops, result_iops(result), l->mean,
+                        (unsigned long long)l->p50, (unsigned long long)l->p90,
+                        (unsigned long long)l->p99, (unsigned long long)l->p999,
+                        (unsigned long long)l->max);
+            }
+            if (latency_enabled) {
+                fprintf(out, ", \"latency_ns\": {");
+                for (int p = 0; p < PHASE_COUNT; p++) {
+                    const PhaseLatency *l = &result->latency[p];
+                    fprintf(out, "%s\"%s\": {\"count\": %llu, \"mean\": %.1f, \"p50\": %llu, "
+                            "\"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+                            p ? ", " : "", phase_names[p], (unsigned long long)l->count, l->mean,
+                            (unsigned long long)l->p50, (unsigned long long)l->p90,
+                            (unsigned long long)l->p99, (unsigned long long)l->p999,
+                            (unsigned long long)l->max);
+                }
+                fprintf(out, "}");
+            }
+            fprintf(out, "}");
+            first = 0;
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+// One CSV row per timed run; host columns repeat so rows stand alone
+static void write_results_csv(FILE *out, const MethodResult *results, String filename,
+                              const HostInfo *host) {
+    fprintf(out, "method,key,label,run,hash,bytes,seconds,gbps,block_size,threads,readers,consumers,"
+            "cache,resident_fraction,cpu_seconds,main_cpu_seconds,worker_cpu_seconds,"
+            "cpu_seconds_per_gb,cycles_per_byte,minor_faults,major_faults,voluntary_switches,"
+            "involuntary_switches,read_bytes,rchar,syscr,file,chunk_size,max_inflight_bytes,pin,auto_tune,order,seed,access_seed,"
+            "hostname,cpu_model,cpu_mhz,cpus,numa_nodes,kernel,filesystem,device");
+    if (perf_enabled) {
+        for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+            fprintf(out, ",%s", perf_event_name((PerfEvent)e));
+        }
+    }
+    for (int p = 0; latency_enabled && p < PHASE_COUNT; p++) {
+        fprintf(out, ",%s_count,%s_mean_ns,%s_p50_ns,%s_p90_ns,%s_p99_ns,%s_p999_ns,%s_max_ns",
+                phase_names[p], phase_names[p], phase_names[p], phase_names[p],
+                phase_names[p], phase_names[p], phase_names[p]);
+    }
+    int with_iops = iops_selected();
+    if (with_iops) {
+        fprintf(out, ",ops,iops,op_mean_ns,op_p50_ns,op_p90_ns,op_p99_ns,op_p999_ns,op_max_ns");
+    }
+    fputc('\n', out);
+    for (int m = 0; m < num_selections; m++) {
+        for (int r = 0; r < repeat_count; r++) {
+            const MethodResult *result = &results[m * repeat_count + r];
+            if (!result->ok) {
+                continue;
+            }
+            print_csv_string(out, selections[m].method->name);
+            fprintf(out, ",%s,", selections[m].method->key);
+            print_csv_string(out, selections[m].label);
+            fprintf(out, ",%d,", r);
+            if (!result->unhashed) {
+                fprintf(out, "%016llx", (unsigned long long)result->hash);
+            }
+            fprintf(out, ",%zu,%.9f,%.6f,%zu,%d,%d,%d,%s,%.4f,%.6f,%.6f,%.6f,%.6f,%.4f,",
+                    result->total_bytes,
+                    result->seconds, result_gbps(result), result->block_size,
+                    result->threads, result->readers, result->consumers,
+                    cache_state_names[result->cache], result->resident_fraction,
+                    result->cpu_seconds, result->main_cpu_seconds, result->worker_cpu_seconds,
+                    result_cpu_per_gb(result), result_cycles_per_byte(result));
+            const ResourceUsage *usage = &result->usage;
+            fprintf(out, "%ld,%ld,%ld,%ld,", usage->minor_faults, usage->major_faults,
+                    usage->voluntary_switches, usage->involuntary_switches);
+            if (usage->have_io) {
+                fprintf(out, "%llu,%llu,%llu,", (unsigned long long)usage->read_bytes,
+                        (unsigned long long)usage->rchar, (unsigned long long)usage->syscr);
+            } else {
+                fprintf(out, ",,,");
+            }
+            print_csv_string(out, filename);
+            fprintf(out, ",%zu,%zu,%s,%d,%s,%llu,%llu,", chunk_size, max_inflight_bytes,
+                    topology_policy_name(pin_policy), auto_tune,
+                    schedule_order_name(schedule_order), (unsigned long long)schedule_seed,
+                    (unsigned long long)access_seed);
+            print_csv_string(out, host->hostname);
+            fputc(',', out);
+            print_csv_string(out, host->cpu_model);
+            fprintf(out, ",%.1f,%d,%d,", host->cpu_mhz, host->num_cpus, topology.num_nodes > 0 ? topology.num_nodes : 1);
+            print_csv_string(out, host->kernel);
+            fputc(',', out);
+            print_csv_string(out, host->fs_type);
+            fputc(',', out);
+            print_csv_string(out, host->fs_device);
+            // Counters last; empty where the event was not available
+            for (int e = 0; perf_enabled && e < PERF_NUM_EVENTS; e++) {
+                fputc(',', out);
+                if (result->perf_available & (1u << e)) {
+                    fprintf(out, "%llu", (unsigned long long)result->perf_values[e]);
+                }
+            }
+            for (int p = 0; latency_enabled && p < PHASE_COUNT; p++) {
+                const PhaseLatency *l = &result->latency[p];
+                fprintf(out, ",%llu,%.1f,%llu,%llu,%llu,%llu,%llu", (unsigned long long)l->count,
+                        l->mean, (unsigned long long)l->p50, (unsigned long long)l->p90,
+                        (unsigned long long)l->p99, (unsigned long long)l->p999,
+                        (unsigned long long)l->max);
+            }
+            // Empty for methods other than random IOPS
+            if (with_iops && result->ops > 0) {
+                const PhaseLatency *l = &result->op_latency;
+                fprintf(out, ",%zu,%.1f,%.1f,%llu,%llu,%llu,%llu,%llu", result->ops, result_iops(result),
+                        l->mean, (unsigned long long)l->p50, (unsigned long long)l->p90,
+                        (unsigned long long)l->p99, (unsigned long long)l->p999,
+                        (unsigned long long)l->max);
+            } else if (with_iops) {
+                fprintf(out, ",,,,,,,,");
+            }
+            fputc('\n', out);
+        }
+    }
+}
+
+// Write results in the --format chosen, to --output or stdout
+static void write_results(const MethodResult *results, String filename) {
+    FILE *out = stdout;
+    if (output_path) {
+        out = fopen(output_path, "w");
+        if (!out) {
+            fprintf(stderr, "Error: Cannot open %s for writing\n", output_path);
+            return;
+        }
+    }
+    if (output_format == FORMAT_JSON) {
+        write_results_json(out, results, filename, &host_info);
+    } else {
+        write_results_csv(out, results, filename, &host_info);
+    }
+    if (out != stdout) {
+        fclose(out);
+        if (verbosity >= 1) {
+            printf("Results (%s) written to %s\n", output_format_name(output_format), output_path);
+        }
+    } else {
+        fflush(out);
+    }
+}
+
+// Rounds of one run per method; negative rounds are warmups
+static void run_rounds(BenchSession *session, String filename, MethodResult *results, int quiet) {
+    uint64_t rng = schedule_seed;
+    int order[MAX_SELECTED];
+    for (int round = -warmup_count; round < repeat_count; round++) {
+        for (int k = 0; k < num_selections; k++) {
+            order[k] = k;
+        }
+        if (schedule_order == ORDER_SHUFFLE) {
+            stats_shuffle(order, num_selections, &rng);
+        }
+        if (verbosity >= 2) {
+            if (round < 0) {
+                printf("Warmup round %d order:", round + warmup_count);
+            } else {
+                printf("Round %d order:", round);
+            }
+            for (int k = 0; k < num_selections; k++) {
+                printf(" %d", order[k]);
+            }
+            printf("\n");
+        }
+        for (int k = 0; k < num_selections; k++) {
+            int m = order[k];
+            MethodResult warmup;
+            if (round < 0) {
+                run_method(session, &selections[m], filename, &warmup, verbosity < 2, 1);
+            } else {
+                run_method(session, &selections[m], filename, &results[m * repeat_count + round], quiet, 0);
+            }
+        }
+    }
+}
 
 // Run all file reading benchmarks
-void read_file(String filename) {
-    sequential_read(filename);
-    random_read(filename);
-    sequential_mmap(filename);
-    random_mmap(filename);
-    async_sequential_read(filename);
+void read_file(BenchSession *session, String filename) {
+    MethodResult *results = calloc(num_selections * repeat_count, sizeof(MethodResult));
+    if (!results) {
+        printf("Error: Cannot allocate memory for results\n");
+        return;
+    }
+    if (latency_enabled) {
+        selection_latency = calloc(num_selections * PHASE_COUNT, sizeof(LatencyHistogram));
+        if (!selection_latency) {
+            printf("Error: Cannot allocate memory for latency histograms\n");
+            free(results);
+            return;
+        }
+    }
+    // With repetitions, per-run output is kept for debug level only
+    int quiet = repeat_count > 1 && verbosity < 2;
+    
+    if (schedule_order == ORDER_FIXED) {
+        for (int m = 0; m < num_selections; m++) {
+            MethodResult warmup;
+            for (int w = 0; w < warmup_count; w++) {
+                run_method(session, &selections[m], filename, &warmup, verbosity < 2, 1);
+            }
+            for (int r = 0; r < repeat_count; r++) {
+                run_method(session, &selections[m], filename, &results[m * repeat_count + r], quiet, 0);
+            }
+        }
+    } else {
+        run_rounds(session, filename, results, quiet);
+    }
+    
+    if ((repeat_count > 1 || print_samples) && verbosity >= 0) {
+        print_summary(results);
+    }
+    if (sweep_enabled && verbosity >= 0) {
+        print_sweep_table(results);
+    }
+    if (verbosity >= 1) {
+        print_ceiling_table(results);
+        print_bottleneck_table(results);
+    }
+    if (output_format != FORMAT_TEXT) {
+        write_results(results, filename);
+    }
+    free(results);
+    free(selection_latency);
+    selection_latency = NULL;
+}
+
+// Compare the runs of each method in two result files (--compare) and
+// return the exit status: 0, EXIT_REGRESSION, or 1 if a file is unusable
+static int compare_result_files(const char *baseline_path, const char *candidate_path) {
+    ResultSet baseline, candidate;
+    if (!result_set_load(baseline_path, &baseline)) {
+        fprintf(stderr, "Error: Cannot read results from %s\n", baseline_path);
+        return 1;
+    }
+    if (!result_set_load(candidate_path, &candidate)) {
+        fprintf(stderr, "Error: Cannot read results from %s\n", candidate_path);
+        result_set_free(&baseline);
+        return 1;
+    }
+    
+    printf("Baseline:  %s\nCandidate: %s\n", baseline_path, candidate_path);
+    printf("Speedup is baseline median / candidate median (> 1: candidate faster); "
+           "%.0f%% bootstrap CI, two-sided Mann-Whitney U\n\n", COMPARE_CONFIDENCE);
+    int width = 22;
+    for (int i = 0; i < baseline.count; i++) {
+        int len = (int)strlen(baseline.series[i].label);
+        width = len > width ? len : width;
+    }
+    printf("%-*s %4s %10s %4s %10s %8s %19s %8s  %s\n", width, "Method", "n", "base",
+           "n", "cand", "speedup", "CI", "p", "verdict");
+    
+    int regressions = 0;
+    uint64_t state = COMPARE_SEED;
+    for (int i = 0; i < baseline.count; i++) {
+        const ResultSeries *base = &baseline.series[i];
+        const ResultSeries *cand = result_set_find(&candidate, base->label);
+        if (!cand) {
+            printf("%-*s %4d %10s\n", width, base->label, base->count, "(not in candidate)");
+            continue;
+        }
+        SampleStats base_stats, cand_stats;
+        stats_compute(base->seconds, base->count, &base_stats);
+        stats_compute(cand->seconds, cand->count, &cand_stats);
+        double speedup = cand_stats.median > 0 ? base_stats.median / cand_stats.median : 0.0;
+        double low, high, u;
+        stats_bootstrap_median_ratio(base->seconds, base->count, cand->seconds, cand->count,
+                                     COMPARE_RESAMPLES, COMPARE_CONFIDENCE, &state, &low, &high);
+        double p = stats_mann_whitney(base->seconds, base->count, cand->seconds, cand->count, &u);
+        
+        const char *verdict = "no significant change";
+        if (p < compare_alpha && speedup < 1.0 - compare_min_change / 100.0) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p < compare_alpha && speedup > 1.0 + compare_min_change / 100.0) {
+            verdict = "improvement";
+        } else if (p < compare_alpha) {
+            verdict = "significant, within threshold";
+        } else if (stats_mann_whitney_min_p(base->count, cand->count) >= compare_alpha) {
+            verdict = "too few runs to tell";
+        }
+        printf("%-*s %4d %10.6f %4d %10.6f %7.3fx  [%7.3f, %7.3f] %8.4f  %s\n", width, base->label,
+               base->count, base_stats.median, cand->count, cand_stats.median, speedup,
+               low, high, p, verdict);
+    }
+    for (int i = 0; i < candidate.count; i++) {
+        if (!result_set_find(&baseline, candidate.series[i].label)) {
+            printf("%-*s %4s %10s %4d %10s\n", width, candidate.series[i].label, "", "",
+                   candidate.series[i].count, "(new)");
+        }
+    }
+    
+    printf("\n%d regression%s (alpha %.3g, threshold %.1f%%)\n", regressions,
+           regressions == 1 ? "" : "s", compare_alpha, compare_min_change);
+    result_set_free(&baseline);
+    result_set_free(&candidate);
+    return regressions > 0 ? EXIT_REGRESSION : 0;
+}
+
+// Option summary shared by --help and argument errors
+static void print_usage(const char *program) {
+    printf("Usage: %s [options] <file>\n", program);
+    printf("       %s --compare BASELINE CANDIDATE [--alpha P] [--min-change PCT]\n", program);
+    printf("  -v, --verbose LEVEL  Set verbosity level (0-2, default: 1)\n");
+    printf("  -p, --pin POLICY     Thread placement: none, compact, scatter, smt (default: none)\n");
+    printf("  -a, --auto-tune      Adapt async reader/consumer counts while running\n");
+    printf("  -c, --chunk-size N   Async readers publish blocks in N-byte slices (e.g. 512K)\n");
+    printf("  -b, --max-inflight-bytes N  Cap bytes read but not yet hashed by async (e.g. 64M)\n");
+    printf("  -m, --methods LIST   Methods to run, with overrides (e.g. seq,async:readers=8)\n");
+    printf("  -r, --repeat N       Timed runs per method; N > 1 prints a summary (default: 1)\n");
+    printf("  -w, --warmup K       Untimed runs per method before the timed ones (default: 0)\n");
+    printf("  -s, --samples        List every timed sample in the summary\n");
+    printf("  -o, --order MODE     Method schedule: fixed, shuffle, interleave (default: fixed)\n");
+    printf("      --seed N         Seed for --order shuffle (default: time-based, printed)\n");
+    printf("      --access-seed N  Seed for the rand/rmmap block order and iops offsets (default: time-based, printed)\n");
+    printf("  -f, --format FORMAT  Result format: text, json, csv (default: text)\n");
+    printf("      --output FILE    Write json/csv results to FILE instead of stdout\n");
+    printf("      --perf           Count cycles, instructions, cache/TLB/branch misses, faults\n");
+    printf("      --latency        Per-block read/queue-wait/hash latency percentiles\n");
+    printf("      --sample-ms N    Throughput sampling period in milliseconds (default: 200)\n");
+    printf("      --timeseries FILE  Write sampled throughput, depth and threads as CSV\n");
+    printf("      --no-progress    No live progress line (shown only on a terminal)\n");
+    printf("      --trace FILE     Write a Chrome/Perfetto trace of every thread's spans\n");
+    printf("      --cold           Evict the file from the page cache before every run\n");
+    printf("      --drop-caches    With --cold, also drop all system caches (needs root)\n");
+    printf("      --sweep          Run each method at every power-of-two block size (4K-256M)\n");
+    printf("      --sweep-range MIN:MAX  Block sizes for --sweep (e.g. 64K:64M)\n");
+    printf("      --compare B C    Compare two --format json/csv result files; exit 2 on regression\n");
+    printf("      --alpha P        Significance level for --compare (default: 0.05)\n");
+    printf("      --min-change PCT Smallest slowdown --compare reports as a regression (default: 2)\n");
+    printf("  -h, --help           Show this help message\n");
 }
 
 int main(int argc, char *argv[]) {
     // Parse options
+    int seed_given = 0;
+    int access_seed_given = 0;
     int i = 1;
     while (i < argc && argv[i][0] == '-') {
         if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
@@ -797,9 +4666,7 @@ int main(int argc, char *argv[]) {
                 verbosity = atoi(argv[i + 1]);
                 if (verbosity < 0 || verbosity > 2) {
                     printf("Error: Verbosity level must be 0, 1, or 2\n");
-                    printf("Usage: %s [options] <file>\n", argv[0]);
-                    printf("  -v, --verbose LEVEL  Set verbosity level (0-2, default: 1)\n");
-                    printf("  -h, --help           Show this help message\n");
+                    print_usage(argv[0]);
                     return 1;
                 }
                 i += 2; // consume option and its value
@@ -808,14 +4675,230 @@ int main(int argc, char *argv[]) {
                 printf("Usage: %s [options] <file>\n", argv[0]);
                 return 1;
             }
+        } else if (strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--pin") == 0) {
+            if (i + 1 < argc && topology_parse_policy(argv[i + 1], &pin_policy)) {
+                i += 2;
+            } else {
+                printf("Error: -p/--pin requires a policy (none, compact, scatter, smt)\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--chunk-size") == 0) {
+            if (i + 1 < argc && parse_size(argv[i + 1], &chunk_size)) {
+                i += 2;
+            } else {
+                printf("Error: -c/--chunk-size requires a size (e.g. 512K)\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--max-inflight-bytes") == 0) {
+            if (i + 1 < argc && parse_size(argv[i + 1], &max_inflight_bytes)) {
+                i += 2;
+            } else {
+                printf("Error: -b/--max-inflight-bytes requires a size (e.g. 64M)\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--methods") == 0) {
+            if (i + 1 < argc && parse_method_list(argv[i + 1]) && num_selections > 0) {
+                i += 2;
+            } else {
+                printf("Error: -m/--methods requires a list (e.g. seq,async:readers=8)\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--repeat") == 0) {
+            if (i + 1 < argc && (repeat_count = atoi(argv[i + 1])) >= 1) {
+                i += 2;
+            } else {
+                printf("Error: -r/--repeat requires a run count of at least 1\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "--warmup") == 0) {
+            if (i + 1 < argc && (warmup_count = atoi(argv[i + 1])) >= 0) {
+                i += 2;
+            } else {
+                printf("Error: -w/--warmup requires a run count of at least 0\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--samples") == 0) {
+            print_samples = 1;
+            i++;
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--order") == 0) {
+            if (i + 1 < argc && parse_schedule_order(argv[i + 1], &schedule_order)) {
+                i += 2;
+            } else {
+                printf("Error: -o/--order requires a mode (fixed, shuffle, interleave)\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            if (i + 1 < argc && parse_seed(argv[i + 1], &schedule_seed)) {
+                seed_given = 1;
+                i += 2;
+            } else {
+                printf("Error: --seed requires a non-negative 64-bit number\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--access-seed") == 0) {
+            if (i + 1 < argc && parse_seed(argv[i + 1], &access_seed)) {
+                access_seed_given = 1;
+                i += 2;
+            } else {
+                printf("Error: --access-seed requires a non-negative 64-bit number\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--format") == 0) {
+            if (i + 1 < argc && strcmp(argv[i + 1], "text") == 0) {
+                output_format = FORMAT_TEXT;
+            } else if (i + 1 < argc && strcmp(argv[i + 1], "json") == 0) {
+                output_format = FORMAT_JSON;
+            } else if (i + 1 < argc && strcmp(argv[i + 1], "csv") == 0) {
+                output_format = FORMAT_CSV;
+            } else {
+                printf("Error: -f/--format requires a format (text, json, csv)\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+            i += 2;
+        } else if (strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) {
+                output_path = argv[i + 1];
+                i += 2;
+            } else {
+                printf("Error: --output requires a file name\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            perf_enabled = 1;
+            i++;
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            latency_enabled = 1;
+            i++;
+        } else if (strcmp(argv[i], "--sample-ms") == 0) {
+            if (i + 1 < argc) {
+                sample_ms = atoi(argv[i + 1]);
+                if (sample_ms < MIN_SAMPLE_MS) {
+                    printf("Error: Sample period must be at least %d ms\n", MIN_SAMPLE_MS);
+                    return 1;
+                }
+                i += 2;
+            } else {
+                printf("Error: --sample-ms requires a value\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--timeseries") == 0) {
+            if (i + 1 < argc) {
+                timeseries_path = argv[i + 1];
+                i += 2;
+            } else {
+                printf("Error: --timeseries requires a file name\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--no-progress") == 0) {
+            show_progress = 0;
+            i++;
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 < argc) {
+                trace_path = argv[i + 1];
+                i += 2;
+            } else {
+                printf("Error: --trace requires a file name\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--sweep") == 0) {
+            sweep_enabled = 1;
+            i++;
+        } else if (strcmp(argv[i], "--sweep-range") == 0) {
+            char *colon = i + 1 < argc ? strchr(argv[i + 1], ':') : NULL;
+            if (!colon) {
+                printf("Error: --sweep-range requires MIN:MAX\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+            *colon = '\0';
+            if (!parse_size(argv[i + 1], &sweep_min) || !parse_size(colon + 1, &sweep_max) ||
+                sweep_min == 0 || sweep_min > sweep_max || sweep_max > MAX_BLOCK_SIZE) {
+                printf("Error: --sweep-range needs 0 < MIN <= MAX <= %d bytes\n", MAX_BLOCK_SIZE);
+                return 1;
+            }
+            sweep_enabled = 1;
+            i += 2;
+        } else if (strcmp(argv[i], "--compare") == 0) {
+            if (i + 2 < argc) {
+                compare_baseline = argv[i + 1];
+                compare_candidate = argv[i + 2];
+                i += 3;
+            } else {
+                printf("Error: --compare requires a baseline and a candidate file\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--alpha") == 0) {
+            if (i + 1 < argc) {
+                compare_alpha = atof(argv[i + 1]);
+                if (compare_alpha <= 0.0 || compare_alpha >= 1.0) {
+                    printf("Error: --alpha must be between 0 and 1\n");
+                    return 1;
+                }
+                i += 2;
+            } else {
+                printf("Error: --alpha requires a value\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--min-change") == 0) {
+            if (i + 1 < argc) {
+                compare_min_change = atof(argv[i + 1]);
+                if (compare_min_change < 0.0) {
+                    printf("Error: --min-change must not be negative\n");
+                    return 1;
+                }
+                i += 2;
+            } else {
+                printf("Error: --min-change requires a value\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cold") == 0) {
+            cold_cache = 1;
+            i++;
+        } else if (strcmp(argv[i], "--drop-caches") == 0) {
+            cold_cache = 1;
+            drop_caches = 1;
+            i++;
+        } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--auto-tune") == 0) {
+            auto_tune = 1;
+            i++;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-            printf("Usage: %s [options] <file>\n", argv[0]);
-            printf("  -v, --verbose LEVEL  Set verbosity level (0-2, default: 1)\n");
-            printf("  -h, --help           Show this help message\n");
+            print_usage(argv[0]);
             printf("\nVerbosity levels:\n");
             printf("  0: Only times\n");
             printf("  1: Times and checksums (default)\n");
             printf("  2: All output including debug messages\n");
+            printf("\nPin policies:\n");
+            printf("  compact: Fill one NUMA node, SMT siblings adjacent\n");
+            printf("  scatter: Spread across nodes and physical cores first\n");
+            printf("  smt:     Reader i and consumer i share a physical core\n");
+            printf("\nMethods (--methods key[:name=value...],...; all = every method):\n");
+            printf("  seq, rand, mmap, rmmap, alt, altmmap, memhash, memcpy  block=SIZE\n");
+            printf("  async    block=SIZE readers=N (default %d) consumers=N (default %d)\n",
+                   NUM_READERS, NUM_CONSUMERS);
+            printf("  steal    block=SIZE workers=N (default %d)\n", NUM_WORKERS);
+            printf("  ordered  block=SIZE readers=N (default %d) window=N (default %d)\n",
+                   NUM_READERS, REORDER_WINDOW);
+            printf("  uring    block=SIZE depth=N (default %d)\n", URING_QUEUE_DEPTH);
+            printf("  iops     block=SIZE (4K-1M, default 8K) ops=N (default %d) workers=N (default %d)\n"
+                   "           depth=N (default %d) direct=0|1; only run when named\n",
+                   IOPS_OPS, IOPS_WORKERS, IOPS_QUEUE_DEPTH);
             return 0;
         } else {
             printf("Unknown option: %s\n", argv[i]);
@@ -824,6 +4907,10 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (compare_baseline) {
+        return compare_result_files(compare_baseline, compare_candidate);
+    }
+    
     if (i >= argc) {
         printf("Error: Missing <file> argument\n");
         printf("Usage: %s [options] <file>\n", argv[0]);
@@ -831,12 +4918,113 @@ int main(int argc, char *argv[]) {
     }
 
     String filename = argv[i];
+    
+    // Without --methods, run every file-reading method with its defaults;
+    // iops and the in-memory baselines run only when named
+    if (num_selections == 0) {
+        for (int m = 0; m < NUM_METHODS; m++) {
+            if (!(methods[m].params & PARAM_OPS) && methods[m].ceiling == CEILING_NONE) {
+                add_selection(&methods[m]);
+            }
+        }
+    }
+    
+    if (sweep_enabled && !expand_sweep(filename)) {
+        return 1;
+    }
+    
+    // Structured results on stdout replace the text output entirely
+    if (output_format != FORMAT_TEXT && !output_path) {
+        verbosity = -1;
+    }
+    
+    host_info_collect(&host_info, filename);
+    cpu_hz = host_info.cpu_mhz * 1e6;
+    
+    // Record the shuffle seed so a schedule can be replayed with --seed
+    if (!seed_given) {
+        schedule_seed = (uint64_t)time(NULL) ^ ((uint64_t)getpid() << 32);
+    }
+    if (schedule_order == ORDER_SHUFFLE && verbosity >= 0) {
+        printf("Schedule: shuffle, seed %llu\n", (unsigned long long)schedule_seed);
+    }
+    // Every run of rand and rmmap visits the blocks in the same permutation
+    if (!access_seed_given) {
+        access_seed = (uint64_t)time(NULL) ^ ((uint64_t)getpid() << 32) ^ 0xB10C;  // not the schedule seed
+    }
+    for (int m = 0; m < num_selections && verbosity >= 0; m++) {
+        if (selections[m].method->run == random_read || selections[m].method->run == random_mmap ||
+            selections[m].method->run == iops_read) {
+            printf("Random block order: permutation, seed %llu\n", (unsigned long long)access_seed);
+            break;
+        }
+    }
+
+    if (!topology_discover(&topology)) {
+        if (pin_policy != PIN_NONE) {
+            fprintf(stderr, "Warning: CPU topology unavailable, pinning disabled\n");
+        }
+        pin_policy = PIN_NONE;
+    }
 
     if (verbosity >= 2) {
         printf("Verbosity level: %d\n", verbosity);
         printf("Input file: %s\n", filename);
+        printf("Topology: %d CPUs, %d NUMA nodes, pin policy %s\n",
+               topology.num_cpus, topology.num_nodes, topology_policy_name(pin_policy));
     }
 
-    read_file(filename);
+    // One session (worker threads + pre-faulted buffers) serves every method.
+    // Each run resizes the buffers to its own block and reserves just the
+    // buffers its method takes (see method_buffers).
+    BenchSession session;
+    if (!session_init(&session, MAX_SESSION_BUFFERS)) {
+        printf("Error: Cannot create benchmark session\n");
+        topology_free(&topology);
+        return 1;
+    }
+    
+    // The live line only makes sense on a terminal, and never in quiet modes
+    show_progress = show_progress && verbosity >= 0 && isatty(STDERR_FILENO);
+    if (timeseries_path) {
+        timeseries_file = fopen(timeseries_path, "w");
+        if (!timeseries_file) {
+            fprintf(stderr, "Error: Cannot open %s for writing\n", timeseries_path);
+            session_destroy(&session);
+            topology_free(&topology);
+            return 1;
+        }
+        fprintf(timeseries_file, "label,key,warmup,run,seconds,bytes,gbps,depth,threads\n");
+    }
+    if (trace_path) {
+        main_thread = pthread_self();
+        trace_log_init(&trace_log, now_ns(), TRACE_MAX_EVENTS);
+        tracing = 1;
+    }
+    read_file(&session, filename);
+    if (tracing) {
+        // Pool workers are idle between methods, so their buffers are stable
+        size_t dropped = 0;
+        long spans = trace_log_write(&trace_log, trace_path, &dropped);
+        if (spans < 0) {
+            fprintf(stderr, "Error: Cannot write trace %s\n", trace_path);
+        } else {
+            if (verbosity >= 1) {
+                printf("Trace: %ld spans written to %s\n", spans, trace_path);
+            }
+            if (dropped > 0) {
+                fprintf(stderr, "Warning: %zu spans dropped past %d per thread\n",
+                        dropped, TRACE_MAX_EVENTS);
+            }
+        }
+        tracing = 0;
+        trace_log_free(&trace_log);
+    }
+    if (timeseries_file) {
+        fclose(timeseries_file);
+    }
+    session_destroy(&session);
+    phase_free_recorders();
+    topology_free(&topology);
     return 0;
 }
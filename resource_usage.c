@@ -0,0 +1,84 @@
+/*
+ * Resource Usage Implementation
+ */
+
+#include "resource_usage.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+// "name: value" lines; tasks without I/O accounting have no such file
+static int read_proc_io(ResourceUsage *usage) {
+    FILE *file = fopen("/proc/self/io", "r");
+    if (!file) {
+        return 0;
+    }
+    char name[64];
+    unsigned long long value;
+    int found = 0;
+    while (fscanf(file, "%63[^:]: %llu\n", name, &value) == 2) {
+        if (strcmp(name, "rchar") == 0) {
+            usage->rchar = value;
+            found++;
+        } else if (strcmp(name, "syscr") == 0) {
+            usage->syscr = value;
+            found++;
+        } else if (strcmp(name, "read_bytes") == 0) {
+            usage->read_bytes = value;
+            found++;
+        }
+    }
+    fclose(file);
+    return found == 3;
+}
+
+// Reading /proc/self/io is itself a read: the calls and bytes one snapshot
+// adds to a delta, measured once from two back-to-back snapshots
+static int self_io_measured = 0;
+static uint64_t self_rchar = 0;
+static uint64_t self_syscr = 0;
+
+static void snapshot(ResourceUsage *usage) {
+    memset(usage, 0, sizeof(*usage));
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        usage->minor_faults = ru.ru_minflt;
+        usage->major_faults = ru.ru_majflt;
+        usage->voluntary_switches = ru.ru_nvcsw;
+        usage->involuntary_switches = ru.ru_nivcsw;
+    }
+    usage->have_io = read_proc_io(usage);
+}
+
+void resource_usage_snapshot(ResourceUsage *usage) {
+    if (!self_io_measured) {
+        ResourceUsage first, second;
+        snapshot(&first);
+        snapshot(&second);
+        if (first.have_io && second.have_io) {
+            self_rchar = second.rchar - first.rchar;
+            self_syscr = second.syscr - first.syscr;
+        }
+        self_io_measured = 1;
+    }
+    snapshot(usage);
+}
+
+static uint64_t minus_self(uint64_t value, uint64_t self) {
+    return value > self ? value - self : 0;
+}
+
+void resource_usage_delta(const ResourceUsage *start, const ResourceUsage *end,
+                          ResourceUsage *delta) {
+    memset(delta, 0, sizeof(*delta));
+    delta->minor_faults = end->minor_faults - start->minor_faults;
+    delta->major_faults = end->major_faults - start->major_faults;
+    delta->voluntary_switches = end->voluntary_switches - start->voluntary_switches;
+    delta->involuntary_switches = end->involuntary_switches - start->involuntary_switches;
+    delta->have_io = start->have_io && end->have_io;
+    if (delta->have_io) {
+        delta->rchar = minus_self(end->rchar - start->rchar, self_rchar);
+        delta->syscr = minus_self(end->syscr - start->syscr, self_syscr);
+        delta->read_bytes = end->read_bytes - start->read_bytes;
+    }
+}
@@ -0,0 +1,31 @@
+/*
+ * Resource Usage Header
+ *
+ * Process-wide getrusage and /proc/self/io snapshots, so a measured region
+ * can report the faults, context switches and I/O it caused
+ */
+
+#ifndef RESOURCE_USAGE_H
+#define RESOURCE_USAGE_H
+
+#include <stdint.h>
+
+typedef struct {
+    long minor_faults;
+    long major_faults;          // faults that had to wait for the device
+    long voluntary_switches;    // blocked (I/O, locks, semaphores)
+    long involuntary_switches;  // preempted
+    int have_io;                // /proc/self/io could be read
+    uint64_t rchar;             // bytes returned by read-like syscalls
+    uint64_t syscr;             // read-like syscalls
+    uint64_t read_bytes;        // bytes fetched from the block device
+} ResourceUsage;
+
+void resource_usage_snapshot(ResourceUsage *usage);
+
+// end - start, field by field (I/O only when both snapshots have it), less
+// the reads the snapshot itself makes
+void resource_usage_delta(const ResourceUsage *start, const ResourceUsage *end,
+                          ResourceUsage *delta);
+
+#endif // RESOURCE_USAGE_H
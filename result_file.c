@@ -0,0 +1,210 @@
+/*
+ * Result File Implementation
+ */
+
+#include "result_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LINE 8192
+#define MAX_FIELDS 128
+
+const ResultSeries *result_set_find(const ResultSet *set, const char *label) {
+    for (int i = 0; i < set->count; i++) {
+        if (strcmp(set->series[i].label, label) == 0) {
+            return &set->series[i];
+        }
+    }
+    return NULL;
+}
+
+static int add_sample(ResultSet *set, const char *label, const char *key, double seconds,
+                      double gbps) {
+    ResultSeries *series = (ResultSeries*)result_set_find(set, label);
+    if (!series) {
+        if (set->count == set->capacity) {
+            int capacity = set->capacity ? set->capacity * 2 : 16;
+            ResultSeries *grown = realloc(set->series, capacity * sizeof(ResultSeries));
+            if (!grown) {
+                return 0;
+            }
+            set->series = grown;
+            set->capacity = capacity;
+        }
+        series = &set->series[set->count++];
+        memset(series, 0, sizeof(*series));
+        snprintf(series->label, sizeof(series->label), "%s", label);
+        snprintf(series->key, sizeof(series->key), "%s", key);
+    }
+    if (series->count == series->capacity) {
+        int capacity = series->capacity ? series->capacity * 2 : 16;
+        double *grown = realloc(series->seconds, capacity * sizeof(double));
+        if (!grown) {
+            return 0;
+        }
+        series->seconds = grown;
+        series->capacity = capacity;
+    }
+    series->seconds[series->count++] = seconds;
+    series->gbps = gbps;
+    return 1;
+}
+
+// Decode the JSON string starting at the opening quote into out
+static const char *parse_json_string(const char *p, char *out, size_t size) {
+    size_t len = 0;
+    if (*p != '"') {
+        return NULL;
+    }
+    for (p++; *p && *p != '"'; p++) {
+        char c = *p;
+        if (c == '\\' && p[1]) {
+            p++;
+            c = *p;
+            if (c == 'u') {
+                // Only control characters are escaped this way; keep a placeholder
+                c = '?';
+                for (int i = 0; i < 4 && p[1]; i++) {
+                    p++;
+                }
+            }
+        }
+        if (len + 1 < size) {
+            out[len++] = c;
+        }
+    }
+    out[len] = '\0';
+    return *p == '"' ? p + 1 : NULL;
+}
+
+// Value following "name": on a record line
+static const char *json_field(const char *line, const char *name) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", name);
+    const char *p = strstr(line, pattern);
+    return p ? p + strlen(pattern) : NULL;
+}
+
+// read_file writes one result record per line inside "results"
+static int load_json(FILE *file, ResultSet *set) {
+    char line[MAX_LINE];
+    while (fgets(line, sizeof(line), file)) {
+        if (!strstr(line, "{\"method\": ")) {
+            continue;
+        }
+        char label[128], key[16];
+        const char *label_value = json_field(line, "label");
+        const char *key_value = json_field(line, "key");
+        const char *seconds_value = json_field(line, "seconds");
+        const char *gbps_value = json_field(line, "gbps");
+        if (!label_value || !key_value || !seconds_value ||
+            !parse_json_string(label_value, label, sizeof(label)) ||
+            !parse_json_string(key_value, key, sizeof(key))) {
+            continue;
+        }
+        if (!add_sample(set, label, key, strtod(seconds_value, NULL),
+                        gbps_value ? strtod(gbps_value, NULL) : 0.0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Split one CSV line in place; quoted fields may hold commas and doubled quotes
+static int split_csv(char *line, char **fields, int max_fields) {
+    int count = 0;
+    char *p = line;
+    while (count < max_fields) {
+        char *out = p;
+        fields[count++] = out;
+        if (*p == '"') {
+            p++;
+            while (*p) {
+                if (*p == '"' && p[1] == '"') {
+                    *out++ = '"';
+                    p += 2;
+                } else if (*p == '"') {
+                    p++;
+                    break;
+                } else {
+                    *out++ = *p++;
+                }
+            }
+        }
+        while (*p && *p != ',' && *p != '\n' && *p != '\r') {
+            *out++ = *p++;
+        }
+        int more = *p == ',';
+        *out = '\0';
+        if (!more) {
+            break;
+        }
+        p++;
+    }
+    return count;
+}
+
+static int column_index(char **fields, int count, const char *name) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(fields[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int load_csv(FILE *file, ResultSet *set) {
+    char line[MAX_LINE];
+    char *fields[MAX_FIELDS];
+    if (!fgets(line, sizeof(line), file)) {
+        return 0;
+    }
+    int count = split_csv(line, fields, MAX_FIELDS);
+    int label_col = column_index(fields, count, "label");
+    int key_col = column_index(fields, count, "key");
+    int seconds_col = column_index(fields, count, "seconds");
+    int gbps_col = column_index(fields, count, "gbps");
+    if (label_col < 0 || key_col < 0 || seconds_col < 0) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file)) {
+        count = split_csv(line, fields, MAX_FIELDS);
+        if (count <= label_col || count <= key_col || count <= seconds_col) {
+            continue;
+        }
+        if (!add_sample(set, fields[label_col], fields[key_col], strtod(fields[seconds_col], NULL),
+                        gbps_col >= 0 && gbps_col < count ? strtod(fields[gbps_col], NULL) : 0.0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int result_set_load(const char *path, ResultSet *set) {
+    memset(set, 0, sizeof(*set));
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    int first = fgetc(file);
+    while (first == ' ' || first == '\n' || first == '\r' || first == '\t') {
+        first = fgetc(file);
+    }
+    rewind(file);
+    int ok = first == '{' ? load_json(file, set) : load_csv(file, set);
+    fclose(file);
+    if (!ok || set->count == 0) {
+        result_set_free(set);
+        return 0;
+    }
+    return 1;
+}
+
+void result_set_free(ResultSet *set) {
+    for (int i = 0; i < set->count; i++) {
+        free(set->series[i].seconds);
+    }
+    free(set->series);
+    memset(set, 0, sizeof(*set));
+}
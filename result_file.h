@@ -0,0 +1,34 @@
+/*
+ * Result File Header
+ *
+ * Loads the per-run records written by --format json or --format csv back
+ * into timing samples grouped by method label, for comparing two result sets
+ */
+
+#ifndef RESULT_FILE_H
+#define RESULT_FILE_H
+
+typedef struct {
+    char label[128];      // method label ("Name" or "Name (k=v, ...)")
+    char key[16];         // method key
+    double *seconds;      // one per timed run
+    double gbps;          // at the last run read, for reference
+    int count;
+    int capacity;
+} ResultSeries;
+
+typedef struct {
+    ResultSeries *series;
+    int count;
+    int capacity;
+} ResultSet;
+
+// Load a results file (format detected from its first character);
+// returns 0 if it cannot be read or holds no records
+int result_set_load(const char *path, ResultSet *set);
+void result_set_free(ResultSet *set);
+
+// Series with this label, or NULL
+const ResultSeries *result_set_find(const ResultSet *set, const char *label);
+
+#endif // RESULT_FILE_H
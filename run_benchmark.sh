@@ -101,13 +101,14 @@ run_benchmark() {
     local filename="$1"
     local size="$2"
     local result_file="$RESULT_DIR/${TIMESTAMP}_${size,,}_result.txt"
+    local json_file="$RESULT_DIR/${TIMESTAMP}_${size,,}_result.json"
     
     print_status "Running benchmark on $filename ($size)..."
     
-    # Run read_file and capture all output
-    if ./read_file "$TEST_DIR/$filename" > "$result_file" 2>&1; then
+    # Run read_file and capture all output; machine-readable results go to JSON
+    if ./read_file --format json --output "$json_file" "$TEST_DIR/$filename" > "$result_file" 2>&1; then
         print_success "Benchmark completed for $filename"
-        print_status "Results saved to: $result_file"
+        print_status "Results saved to: $result_file and $json_file"
     else
         print_error "Benchmark failed for $filename"
         # Still save the error output
@@ -0,0 +1,115 @@
+/*
+ * Trace Events Implementation
+ */
+
+#include "trace_events.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void trace_log_init(TraceLog *log, uint64_t origin_ns, size_t max_events) {
+    pthread_mutex_init(&log->mutex, NULL);
+    log->threads = NULL;
+    log->origin_ns = origin_ns;
+    log->max_events = max_events;
+}
+
+void trace_log_free(TraceLog *log) {
+    while (log->threads) {
+        TraceThread *next = log->threads->next;
+        free(log->threads->events);
+        free(log->threads);
+        log->threads = next;
+    }
+    pthread_mutex_destroy(&log->mutex);
+}
+
+TraceThread *trace_log_thread(TraceLog *log, int tid, const char *name) {
+    TraceThread *thread = calloc(1, sizeof(TraceThread));
+    if (!thread) {
+        return NULL;
+    }
+    thread->tid = tid;
+    snprintf(thread->name, sizeof(thread->name), "%s", name);
+    pthread_mutex_lock(&log->mutex);
+    thread->max_events = log->max_events;
+    thread->next = log->threads;
+    log->threads = thread;
+    pthread_mutex_unlock(&log->mutex);
+    return thread;
+}
+
+void trace_thread_add(TraceThread *thread, const char *name, const char *category,
+                      uint64_t start_ns, uint64_t end_ns) {
+    if (thread->count >= thread->max_events) {
+        thread->dropped++;
+        return;
+    }
+    if (thread->count == thread->capacity) {
+        size_t capacity = thread->capacity ? thread->capacity * 2 : 4096;
+        TraceEvent *grown = realloc(thread->events, capacity * sizeof(TraceEvent));
+        if (!grown) {
+            thread->dropped++;
+            return;
+        }
+        thread->events = grown;
+        thread->capacity = capacity;
+    }
+    TraceEvent *event = &thread->events[thread->count++];
+    event->name = name;
+    event->category = category;
+    event->start_ns = start_ns;
+    event->end_ns = end_ns;
+}
+
+// Span and thread names are program-supplied, but may carry user text (labels)
+static void write_json_string(FILE *out, const char *text) {
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char*)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(out, "\\%c", *p);
+        } else if (*p < 0x20) {
+            fprintf(out, "\\u%04x", *p);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+long trace_log_write(TraceLog *log, const char *path, size_t *dropped) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        return -1;
+    }
+    int pid = (int)getpid();
+    long written = 0;
+    *dropped = 0;
+    fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    pthread_mutex_lock(&log->mutex);
+    for (TraceThread *thread = log->threads; thread; thread = thread->next) {
+        fprintf(out, "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, "
+                "\"args\": {\"name\": ", thread != log->threads ? "," : "", pid, thread->tid);
+        write_json_string(out, thread->name);
+        fprintf(out, "}}");
+        for (size_t i = 0; i < thread->count; i++) {
+            const TraceEvent *event = &thread->events[i];
+            // Microseconds with nanosecond precision
+            fprintf(out, ",\n{\"name\": ");
+            write_json_string(out, event->name);
+            fprintf(out, ", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+                    "\"pid\": %d, \"tid\": %d}",
+                    event->category, (event->start_ns - log->origin_ns) / 1e3,
+                    (event->end_ns - event->start_ns) / 1e3, pid, thread->tid);
+            written++;
+        }
+        *dropped += thread->dropped;
+    }
+    pthread_mutex_unlock(&log->mutex);
+    fprintf(out, "\n]}\n");
+    if (fclose(out) != 0) {
+        return -1;
+    }
+    return written;
+}
@@ -0,0 +1,54 @@
+/*
+ * Trace Events Header
+ *
+ * Per-thread span buffers written out in the Chrome Trace Event format
+ * (complete "X" events), which chrome://tracing and Perfetto load directly
+ */
+
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+typedef struct {
+    const char *name;       // static strings only; not copied
+    const char *category;
+    uint64_t start_ns;
+    uint64_t end_ns;
+} TraceEvent;
+
+// Owned and appended to by a single thread, so recording takes no lock
+typedef struct TraceThread {
+    int tid;
+    char name[32];
+    TraceEvent *events;
+    size_t count;
+    size_t capacity;
+    size_t max_events;
+    size_t dropped;         // spans past the per-thread limit
+    struct TraceThread *next;
+} TraceThread;
+
+typedef struct {
+    pthread_mutex_t mutex;  // guards the thread list
+    TraceThread *threads;
+    uint64_t origin_ns;     // timestamps are written relative to this
+    size_t max_events;      // per thread
+} TraceLog;
+
+void trace_log_init(TraceLog *log, uint64_t origin_ns, size_t max_events);
+void trace_log_free(TraceLog *log);
+
+// Register the calling thread (NULL if out of memory)
+TraceThread *trace_log_thread(TraceLog *log, int tid, const char *name);
+
+void trace_thread_add(TraceThread *thread, const char *name, const char *category,
+                      uint64_t start_ns, uint64_t end_ns);
+
+// Write every thread's spans; returns the number written, -1 on error.
+// Threads must not be recording while this runs.
+long trace_log_write(TraceLog *log, const char *path, size_t *dropped);
+
+#endif // TRACE_EVENTS_H
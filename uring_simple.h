@@ -0,0 +1,60 @@
+/*
+ * Simple io_uring Wrapper Header
+ *
+ * Minimal raw-syscall io_uring (no liburing dependency): queue reads,
+ * submit them, reap completions
+ */
+
+#ifndef URING_SIMPLE_H
+#define URING_SIMPLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+// Kernel ring entry types stay opaque here: <linux/io_uring.h> drags in
+// <linux/fs.h>, whose BLOCK_SIZE would clash with the benchmark's own
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+typedef struct {
+    int ring_fd;
+    unsigned entries;
+    unsigned to_submit;      // SQEs queued but not yet submitted
+    // Submission ring
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    struct io_uring_sqe *sqes;
+    // Completion ring
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+    // Mappings
+    void *sq_ptr;
+    void *cq_ptr;
+    size_t sq_size;
+    size_t cq_size;
+    size_t sqes_size;
+} UringQueue;
+
+// Set up a ring with room for entries requests (returns 0 and sets errno on failure)
+int uring_init(UringQueue *ring, unsigned entries);
+void uring_destroy(UringQueue *ring);
+
+// Queue a read of len bytes at offset (returns 0 if the submission ring is full)
+int uring_prep_read(UringQueue *ring, int fd, void *buf, unsigned len, off_t offset,
+                    uint64_t user_data);
+
+// Submit queued reads without waiting (returns number submitted, -1 on error)
+int uring_submit(UringQueue *ring);
+
+// Wait for one completion; res is bytes read or -errno (returns 0 on error)
+int uring_wait(UringQueue *ring, uint64_t *user_data, int *res);
+
+// Reap a completion that has already arrived, without waiting (returns 0 if none)
+int uring_peek(UringQueue *ring, uint64_t *user_data, int *res);
+
+#endif // URING_SIMPLE_H